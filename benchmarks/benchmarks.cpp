@@ -0,0 +1,963 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <execution>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_vector.hpp"
+#include "my_allocators.hpp"
+#include "my_array.hpp"
+#include "my_segmented_vector.hpp"
+#include "my_simd.hpp"
+#include "my_sort.hpp"
+#include "soa_vector.hpp"
+#include "my_vector.hpp"
+
+using myVector::my_vector;
+
+// Every operation is measured for std::vector and my_vector over the element types below and
+// sizes from 16 to 100M (capped so one container stays around 1 GiB).
+//     ./StdVectorArray_bench --benchmark_filter='push_back.*<int>' --benchmark_out=bench.json --benchmark_out_format=json
+
+namespace
+{
+    struct pod64
+    {
+        std::int64_t words[8];
+        auto operator<=>(const pod64&) const = default;
+    };
+
+    // builds the i-th element, distinct enough that comparisons do real work
+    template <typename T>
+    T make_value(std::size_t i) {
+        if constexpr (std::is_same_v<T, int>)
+        {
+            return static_cast<int>(i);
+        } else if constexpr (std::is_same_v<T, pod64>)
+        {
+            pod64 p{};
+            std::fill(std::begin(p.words), std::end(p.words), static_cast<std::int64_t>(i));
+            return p;
+        } else if constexpr (std::is_same_v<T, std::string>)
+        {
+            return "value " + std::to_string(i); // fits the small-string buffer
+        } else {
+            return T(4, static_cast<int>(i));
+        }
+    }
+
+    // reads something out of an element so iteration can't be optimized away
+    template <typename T>
+    std::size_t touch(const T& value) {
+        if constexpr (std::is_same_v<T, int>)
+        {
+            return static_cast<std::size_t>(value);
+        } else if constexpr (std::is_same_v<T, pod64>)
+        {
+            return static_cast<std::size_t>(value.words[0]);
+        } else {
+            return value.size();
+        }
+    }
+
+    template <typename Vector>
+    Vector make_vector(std::size_t n) {
+        Vector v;
+        v.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            v.push_back(make_value<typename Vector::value_type>(i));
+        }
+        return v;
+    }
+
+    template <typename Vector>
+    void set_items(benchmark::State& state, std::size_t per_iteration) {
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * per_iteration));
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * per_iteration *
+                                                          sizeof(typename Vector::value_type)));
+    }
+
+    template <typename Vector>
+    void push_back(benchmark::State& state, bool with_reserve) {
+        using T = typename Vector::value_type;
+        const auto n = static_cast<std::size_t>(state.range(0));
+        const T value = make_value<T>(n);
+        for (auto _ : state)
+        {
+            Vector v;
+            if (with_reserve)
+            {
+                v.reserve(n);
+            }
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                v.push_back(value);
+            }
+            benchmark::DoNotOptimize(v.data());
+            benchmark::ClobberMemory();
+        }
+        set_items<Vector>(state, n);
+    }
+
+    template <typename Vector>
+    void copy(benchmark::State& state) {
+        const Vector source = make_vector<Vector>(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            Vector v(source);
+            benchmark::DoNotOptimize(v.data());
+            benchmark::ClobberMemory();
+        }
+        set_items<Vector>(state, source.size());
+    }
+
+    template <typename Vector>
+    void move(benchmark::State& state) {
+        Vector v = make_vector<Vector>(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            Vector moved(std::move(v));
+            benchmark::DoNotOptimize(moved.data());
+            v = std::move(moved);
+            benchmark::DoNotOptimize(v.data());
+        }
+    }
+
+    template <typename Vector>
+    void iterate(benchmark::State& state) {
+        const Vector v = make_vector<Vector>(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            std::size_t sum = 0;
+            for (const auto& x : v)
+            {
+                sum += touch(x);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        set_items<Vector>(state, v.size());
+    }
+
+    enum class where { front, middle, back };
+
+    // one insert and one erase at the same spot, so the size stays put between iterations
+    template <typename Vector>
+    void insert_erase(benchmark::State& state, where at) {
+        using T = typename Vector::value_type;
+        Vector v = make_vector<Vector>(static_cast<std::size_t>(state.range(0)));
+        v.reserve(v.size() + 1);
+        const T value = make_value<T>(0);
+        const std::size_t index = at == where::front ? 0 : at == where::middle ? v.size() / 2 : v.size();
+        for (auto _ : state)
+        {
+            auto it = v.insert(v.cbegin() + static_cast<std::ptrdiff_t>(index), value);
+            benchmark::DoNotOptimize(&*it);
+            v.erase(v.cbegin() + static_cast<std::ptrdiff_t>(index));
+            benchmark::ClobberMemory();
+        }
+    }
+
+    template <typename Vector>
+    void assign(benchmark::State& state) {
+        const Vector source = make_vector<Vector>(static_cast<std::size_t>(state.range(0)));
+        Vector v;
+        for (auto _ : state)
+        {
+            v.assign(source.begin(), source.end());
+            benchmark::DoNotOptimize(v.data());
+            benchmark::ClobberMemory();
+        }
+        set_items<Vector>(state, source.size());
+    }
+
+    template <typename Vector>
+    void resize(benchmark::State& state) {
+        const auto n = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state)
+        {
+            Vector v;
+            v.resize(n);
+            benchmark::DoNotOptimize(v.data());
+            benchmark::ClobberMemory();
+        }
+        set_items<Vector>(state, n);
+    }
+
+    // equal contents is the worst case: every element gets compared
+    template <typename Vector>
+    void compare(benchmark::State& state) {
+        const Vector a = make_vector<Vector>(static_cast<std::size_t>(state.range(0)));
+        const Vector b(a);
+        for (auto _ : state)
+        {
+            auto order = a <=> b;
+            benchmark::DoNotOptimize(order);
+        }
+        set_items<Vector>(state, a.size());
+    }
+
+    template <typename Vector>
+    void equal(benchmark::State& state) {
+        const Vector a = make_vector<Vector>(static_cast<std::size_t>(state.range(0)));
+        const Vector b(a);
+        for (auto _ : state)
+        {
+            bool same = a == b;
+            benchmark::DoNotOptimize(same);
+        }
+        set_items<Vector>(state, a.size());
+    }
+
+    // two 1M-element containers that only differ in their last element
+    constexpr std::size_t compare_size = 1 << 20;
+
+    template <typename Container>
+    void compare_last_differs(benchmark::State& state, bool use_equal) {
+        using T = std::remove_cvref_t<decltype(std::declval<Container&>()[0])>;
+        auto a = std::make_unique<Container>();
+        auto b = std::make_unique<Container>();
+        if constexpr (requires { a->resize(compare_size); })
+        {
+            a->resize(compare_size);
+        }
+        for (std::size_t i = 0; i < compare_size; ++i)
+        {
+            (*a)[i] = static_cast<T>(i);
+        }
+        *b = *a;
+        (*b)[compare_size - 1] += 1;
+        for (auto _ : state)
+        {
+            if (use_equal)
+            {
+                bool same = *a == *b;
+                benchmark::DoNotOptimize(same);
+            } else {
+                auto order = *a <=> *b;
+                benchmark::DoNotOptimize(order);
+            }
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * compare_size * sizeof(T)));
+    }
+
+    // one pass over 1 GiB of floats, summed in 16 independent lanes so the loop vectorizes
+    template <typename Vector>
+    void stream_sum(benchmark::State& state) {
+        constexpr std::size_t lanes = 16;
+        const std::size_t n = (std::size_t{1} << 30) / sizeof(float);
+        Vector v(n, 1.0f);
+        for (auto _ : state)
+        {
+            float acc[lanes] = {};
+            const float* p = v.data();
+            for (std::size_t i = 0; i < n; i += lanes)
+            {
+                for (std::size_t j = 0; j < lanes; ++j)
+                {
+                    acc[j] += p[i + j];
+                }
+            }
+            float sum = 0;
+            for (float a : acc)
+            {
+                sum += a;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * n * sizeof(float)));
+    }
+
+    enum class simd_op { sum, minmax, dot, find, count, transform, inclusive_scan };
+
+    // one pass of op over n elements, through <algorithm>/<numeric> or through myVector::simd
+    template <typename T>
+    void simd_algorithm(benchmark::State& state, simd_op op, bool explicit_simd) {
+        namespace simd = myVector::simd;
+        const auto n = static_cast<std::size_t>(state.range(0));
+        my_vector<T> v(n, T{});
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            v[i] = static_cast<T>(i % 100);
+        }
+        my_vector<T> out(n, T{});
+        const auto twice_plus_one = [](T x) { return static_cast<T>(x * 2 + 1); };
+        for (auto _ : state)
+        {
+            switch (op)
+            {
+            case simd_op::sum:
+                benchmark::DoNotOptimize(explicit_simd ? simd::sum(v) : std::accumulate(v.begin(), v.end(), T{}));
+                break;
+            case simd_op::minmax:
+                if (explicit_simd)
+                {
+                    benchmark::DoNotOptimize(simd::minmax(v));
+                } else {
+                    benchmark::DoNotOptimize(std::minmax_element(v.begin(), v.end()));
+                }
+                break;
+            case simd_op::dot:
+                benchmark::DoNotOptimize(explicit_simd ? simd::dot(v, v) : std::inner_product(v.begin(), v.end(), v.begin(), T{}));
+                break;
+            case simd_op::find:
+                benchmark::DoNotOptimize(explicit_simd ? simd::find(v, T{100})
+                                                       : static_cast<std::size_t>(std::find(v.begin(), v.end(), T{100}) - v.begin()));
+                break;
+            case simd_op::count:
+                benchmark::DoNotOptimize(explicit_simd ? simd::count(v, T{42})
+                                                       : static_cast<std::size_t>(std::count(v.begin(), v.end(), T{42})));
+                break;
+            case simd_op::transform:
+                if (explicit_simd)
+                {
+                    simd::transform(v, out, twice_plus_one);
+                } else {
+                    std::transform(v.begin(), v.end(), out.begin(), twice_plus_one);
+                }
+                benchmark::DoNotOptimize(out.data());
+                break;
+            case simd_op::inclusive_scan:
+                if (explicit_simd)
+                {
+                    simd::inclusive_scan(v, out);
+                } else {
+                    std::inclusive_scan(v.begin(), v.end(), out.begin());
+                }
+                benchmark::DoNotOptimize(out.data());
+                break;
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * n * sizeof(T)));
+    }
+
+    // re-filling a 16 KiB scratch buffer, with a zero (one repeated byte) and a non-zero value
+    template <typename Array>
+    void array_fill(benchmark::State& state, float value) {
+        auto scratch = std::make_unique<Array>();
+        for (auto _ : state)
+        {
+            scratch->fill(value);
+            benchmark::DoNotOptimize(scratch->data());
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * sizeof(Array)));
+    }
+
+    template <typename Array>
+    void array_swap(benchmark::State& state) {
+        auto a = std::make_unique<Array>();
+        auto b = std::make_unique<Array>();
+        a->fill(1.0f);
+        b->fill(2.0f);
+        for (auto _ : state)
+        {
+            a->swap(*b);
+            benchmark::DoNotOptimize(a->data());
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * 2 * sizeof(Array)));
+    }
+
+    enum class contiguous_op { copy, equal, construct };
+
+    // <algorithm> over my_vector's own iterators, or over a std::span of it: libstdc++ only turns
+    // std::copy/std::equal into memmove/memcmp for pointers and its own wrappers, and the span is
+    // what a contiguous_range my_vector converts to
+    void contiguous_algorithm(benchmark::State& state, contiguous_op op, bool through_span) {
+        const auto n = static_cast<std::size_t>(state.range(0));
+        my_vector<int> v(n);
+        std::iota(v.begin(), v.end(), 0);
+        std::vector<int> out(v.begin(), v.end());
+        const std::span<const int> s(v);
+        for (auto _ : state)
+        {
+            switch (op)
+            {
+            case contiguous_op::copy:
+                benchmark::DoNotOptimize(through_span ? std::copy(s.begin(), s.end(), out.data())
+                                                      : std::copy(v.begin(), v.end(), out.data()));
+                break;
+            case contiguous_op::equal:
+                benchmark::DoNotOptimize(through_span ? std::equal(s.begin(), s.end(), out.data())
+                                                      : std::equal(v.begin(), v.end(), out.data()));
+                break;
+            case contiguous_op::construct:
+            {
+                my_vector<int> copy = through_span ? my_vector<int>(s.begin(), s.end()) : my_vector<int>(v.begin(), v.end());
+                benchmark::DoNotOptimize(copy.data());
+                break;
+            }
+            }
+            benchmark::ClobberMemory();
+        }
+        set_items<my_vector<int>>(state, n);
+    }
+
+    // the element access and iterator loops my_vector_checks.hpp instruments. This binary builds
+    // with the checks off, where the iterator is a bare pointer and the loops should match std::vector.
+    static_assert(sizeof(my_vector<int>::iterator) == sizeof(int*) && sizeof(my_vector<int>) == sizeof(std::vector<int>));
+
+    enum class access_op { index, iterate, back };
+
+    template <typename Vector>
+    void element_access(benchmark::State& state, access_op op) {
+        const auto n = static_cast<std::size_t>(state.range(0));
+        Vector v(n);
+        std::iota(v.begin(), v.end(), 0);
+        for (auto _ : state)
+        {
+            long long sum = 0;
+            switch (op)
+            {
+            case access_op::index:
+                for (std::size_t i = 0; i < v.size(); ++i)
+                {
+                    sum += v[i];
+                }
+                break;
+            case access_op::iterate:
+                for (auto it = v.begin(); it != v.end(); ++it)
+                {
+                    sum += *it;
+                }
+                break;
+            case access_op::back:
+                // a stack: read the top, pop it, push it back
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const int top = v.back();
+                    sum += top + v.front();
+                    v.pop_back();
+                    v.push_back(top + 1);
+                }
+                break;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        set_items<Vector>(state, n);
+    }
+
+    enum class sort_input { random, sorted, reversed };
+    enum class sort_algorithm { std_sort, std_sort_par, parallel_sort, parallel_sort_merge, parallel_stable_sort };
+
+    // sorting a fresh copy of n ints per iteration; range(1) caps the threads of the myVector sorts.
+    // parallel_sort_merge passes a lambda, which hides the key type and forces the merge sort.
+    void sort_ints(benchmark::State& state, sort_input input, sort_algorithm algorithm) {
+        const auto n = static_cast<std::size_t>(state.range(0));
+        my_vector<int> source(n);
+        std::mt19937 rng(1);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            source[i] = input == sort_input::random ? static_cast<int>(rng()) : static_cast<int>(i);
+        }
+        if (input == sort_input::reversed)
+        {
+            std::reverse(source.begin(), source.end());
+        }
+
+        const std::size_t saved_threads = myVector::parallel_sort_threads.exchange(static_cast<std::size_t>(state.range(1)));
+        my_vector<int> v;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            v = source;
+            state.ResumeTiming();
+            switch (algorithm)
+            {
+            case sort_algorithm::std_sort:
+                std::sort(v.begin(), v.end());
+                break;
+            case sort_algorithm::std_sort_par:
+                std::sort(std::execution::par, v.begin(), v.end());
+                break;
+            case sort_algorithm::parallel_sort:
+                myVector::parallel_sort(v);
+                break;
+            case sort_algorithm::parallel_sort_merge:
+                myVector::parallel_sort(v, [](int a, int b) { return a < b; });
+                break;
+            case sort_algorithm::parallel_stable_sort:
+                myVector::parallel_stable_sort(v);
+                break;
+            }
+            benchmark::DoNotOptimize(v.data());
+            benchmark::ClobberMemory();
+        }
+        myVector::parallel_sort_threads = saved_threads;
+        set_items<my_vector<int>>(state, n);
+    }
+
+    // std::execution::par construction; compare with copy/std::vector and resize/std::vector
+    template <typename Vector>
+    void copy_par(benchmark::State& state) {
+        const Vector source = make_vector<Vector>(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            Vector v(std::execution::par, source);
+            benchmark::DoNotOptimize(v.data());
+            benchmark::ClobberMemory();
+        }
+        set_items<Vector>(state, source.size());
+    }
+
+    template <typename Vector>
+    void fill_par(benchmark::State& state) {
+        using T = typename Vector::value_type;
+        const auto n = static_cast<std::size_t>(state.range(0));
+        const T value = make_value<T>(n);
+        for (auto _ : state)
+        {
+            Vector v(std::execution::par, n, value);
+            benchmark::DoNotOptimize(v.data());
+            benchmark::ClobberMemory();
+        }
+        set_items<Vector>(state, n);
+    }
+
+    // Producers appending into one shared container, 1 to N threads. The container is shared by
+    // every thread of a run; thread 0 empties it after the run.
+    constexpr std::size_t appends_per_iteration = 1 << 16;
+
+    void concurrent_push_back(benchmark::State& state) {
+        static myVector::concurrent_vector<int> shared;
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < appends_per_iteration; ++i)
+            {
+                shared.push_back(static_cast<int>(i));
+            }
+        }
+        if (state.thread_index() == 0)
+        {
+            shared.clear();
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * appends_per_iteration));
+    }
+
+    // what concurrent_vector replaces
+    void locked_push_back(benchmark::State& state) {
+        static my_vector<int> shared;
+        static std::mutex     mutex;
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < appends_per_iteration; ++i)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                shared.push_back(static_cast<int>(i));
+            }
+        }
+        if (state.thread_index() == 0)
+        {
+            shared = my_vector<int>();
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * appends_per_iteration));
+    }
+
+    // 144 bytes with a std::string inside: growth has to move-construct every element one by one
+    struct heavy
+    {
+        std::string                  name;
+        std::array<std::int64_t, 14> payload;
+    };
+
+    // builds n elements with push_back, then walks them once
+    template <typename Container>
+    void append_then_iterate(benchmark::State& state) {
+        const auto n = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state)
+        {
+            Container c;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                c.push_back(heavy{"element " + std::to_string(i % 100), {static_cast<std::int64_t>(i)}});
+            }
+            std::int64_t sum = 0;
+            for (const heavy& h : c)
+            {
+                sum += h.payload[0] + static_cast<std::int64_t>(h.name.size());
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+    }
+
+    // A wide 80-byte record of which the scans below read one or two fields
+    struct record
+    {
+        std::int64_t id;
+        double       price;
+        double       quantity;
+        std::int64_t timestamp;
+        std::int32_t venue;
+        std::int32_t flags;
+        double       bid;
+        double       ask;
+        std::int64_t trader;
+        std::int64_t order;
+    };
+
+    using record_columns = myVector::soa_vector<std::int64_t, double, double, std::int64_t, std::int32_t, std::int32_t,
+                                                double, double, std::int64_t, std::int64_t>;
+
+    record make_record(std::size_t i) {
+        const auto x = static_cast<double>(i % 1000);
+        const auto n = static_cast<std::int64_t>(i);
+        return {n, x, x / 2, n, 1, 0, x - 1, x + 1, n, n};
+    }
+
+    void scan_aos(benchmark::State& state, bool two_fields) {
+        my_vector<record> records;
+        for (std::size_t i = 0; i < static_cast<std::size_t>(state.range(0)); ++i)
+        {
+            records.push_back(make_record(i));
+        }
+        for (auto _ : state)
+        {
+            double sum = 0;
+            for (const record& r : records)
+            {
+                sum += two_fields ? r.price * r.quantity : r.price;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * records.size()));
+    }
+
+    void scan_soa(benchmark::State& state, bool two_fields) {
+        record_columns records;
+        for (std::size_t i = 0; i < static_cast<std::size_t>(state.range(0)); ++i)
+        {
+            const record r = make_record(i);
+            records.emplace_back(r.id, r.price, r.quantity, r.timestamp, r.venue, r.flags, r.bid, r.ask, r.trader, r.order);
+        }
+        for (auto _ : state)
+        {
+            const std::span<const double> price = std::as_const(records).column<1>();
+            const std::span<const double> quantity = std::as_const(records).column<2>();
+            double sum = 0;
+            for (std::size_t i = 0; i < price.size(); ++i)
+            {
+                sum += two_fields ? price[i] * quantity[i] : price[i];
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * records.size()));
+    }
+
+    // inserting n ints into the middle of a 1000-element vector from a single-pass source
+    template <typename Vector>
+    void insert_from_istream(benchmark::State& state) {
+        const auto n = static_cast<std::size_t>(state.range(0));
+        std::ostringstream text;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            text << i << ' ';
+        }
+        const std::string words = text.str();
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            Vector v(1000, 0);
+            std::istringstream in(words);
+            state.ResumeTiming();
+            v.insert(v.cbegin() + 500, std::istream_iterator<int>(in), std::istream_iterator<int>());
+            benchmark::DoNotOptimize(v.data());
+        }
+        set_items<Vector>(state, n);
+    }
+
+    template <typename Vector>
+    void insert_from_list(benchmark::State& state) {
+        const auto n = static_cast<std::size_t>(state.range(0));
+        std::list<int> source;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            source.push_back(static_cast<int>(i));
+        }
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            Vector v(1000, 0);
+            state.ResumeTiming();
+            v.insert(v.cbegin() + 500, source.begin(), source.end());
+            benchmark::DoNotOptimize(v.data());
+        }
+        set_items<Vector>(state, n);
+    }
+
+    // keeps a sorted vector of n ints sorted while inserting and erasing in the middle
+    template <typename Vector>
+    void sorted_insert(benchmark::State& state) {
+        const auto n = static_cast<std::size_t>(state.range(0));
+        Vector v;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            v.push_back(static_cast<int>(2 * i));
+        }
+        unsigned seed = 12345;
+        for (auto _ : state)
+        {
+            seed = seed * 1103515245u + 12345u;
+            int x = static_cast<int>(seed % (2 * n)) | 1;
+            auto pos = std::lower_bound(v.cbegin(), v.cend(), x);
+            // insert may reallocate, so erase through the iterator it returns
+            v.erase(v.insert(pos, x));
+        }
+    }
+
+    constexpr std::int64_t min_size = 16;
+    constexpr std::int64_t max_size = 100'000'000;
+    constexpr std::int64_t max_bytes = std::int64_t{1} << 30;
+
+    // 16, 256, 4K, 64K, 1M, 16M and 100M, dropping the sizes that would not fit the byte budget
+    template <typename T>
+    void sizes(benchmark::internal::Benchmark* b) {
+        const std::int64_t cap = std::min<std::int64_t>(max_size, max_bytes / static_cast<std::int64_t>(sizeof(T)));
+        for (std::int64_t n = min_size; n < max_size; n *= 16)
+        {
+            if (n <= cap)
+            {
+                b->Arg(n);
+            }
+        }
+        if (max_size <= cap)
+        {
+            b->Arg(max_size);
+        }
+    }
+
+    template <typename Vector>
+    void register_container(const std::string& name) {
+        using T = typename Vector::value_type;
+        auto add = [&](const std::string& op, auto fn) {
+            benchmark::RegisterBenchmark((op + "/" + name).c_str(), fn)->Apply(sizes<T>)->Unit(benchmark::kMicrosecond);
+        };
+        add("push_back", [](benchmark::State& s) { push_back<Vector>(s, false); });
+        add("push_back_reserve", [](benchmark::State& s) { push_back<Vector>(s, true); });
+        add("copy", copy<Vector>);
+        add("move", move<Vector>);
+        add("iterate", iterate<Vector>);
+        add("insert_erase_front", [](benchmark::State& s) { insert_erase<Vector>(s, where::front); });
+        add("insert_erase_middle", [](benchmark::State& s) { insert_erase<Vector>(s, where::middle); });
+        add("insert_erase_back", [](benchmark::State& s) { insert_erase<Vector>(s, where::back); });
+        add("assign", assign<Vector>);
+        add("resize", resize<Vector>);
+        add("compare", compare<Vector>);
+        add("equal", equal<Vector>);
+    }
+
+    template <typename T>
+    void register_element(const std::string& type_name) {
+        register_container<std::vector<T>>("std::vector<" + type_name + ">");
+        register_container<my_vector<T>>("my_vector<" + type_name + ">");
+    }
+
+    template <typename T>
+    void register_parallel(const std::string& type_name) {
+        auto add = [&](const std::string& op, auto fn) {
+            benchmark::RegisterBenchmark((op + "/my_vector<" + type_name + ">").c_str(), fn)
+                ->Arg(1 << 20)
+                ->Arg(1 << 24)
+                ->Arg(std::min(max_size, max_bytes / static_cast<std::int64_t>(sizeof(T))))
+                ->Unit(benchmark::kMillisecond)
+                ->UseRealTime();
+        };
+        add("copy_par", copy_par<my_vector<T>>);
+        add("fill_par", fill_par<my_vector<T>>);
+    }
+
+    template <typename Vector>
+    void register_int_workloads(const std::string& name) {
+        benchmark::RegisterBenchmark(("insert_from_istream/" + name).c_str(), insert_from_istream<Vector>)
+            ->Arg(1'000'000)
+            ->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(("insert_from_list/" + name).c_str(), insert_from_list<Vector>)
+            ->Arg(1'000'000)
+            ->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark(("sorted_insert/" + name).c_str(), sorted_insert<Vector>)->Arg(100'000);
+    }
+
+    template <typename Container>
+    void register_append_then_iterate(const std::string& name) {
+        benchmark::RegisterBenchmark(("append_then_iterate/" + name).c_str(), append_then_iterate<Container>)
+            ->RangeMultiplier(16)
+            ->Range(1 << 10, 1 << 22)
+            ->Unit(benchmark::kMillisecond);
+    }
+
+    template <typename Container>
+    void register_compare_1m(const std::string& name) {
+        benchmark::RegisterBenchmark(("compare_1m/" + name).c_str(),
+                                     [](benchmark::State& s) { compare_last_differs<Container>(s, false); });
+        benchmark::RegisterBenchmark(("equal_1m/" + name).c_str(),
+                                     [](benchmark::State& s) { compare_last_differs<Container>(s, true); });
+    }
+
+    template <typename T>
+    void register_simd(const std::string& type_name) {
+        const std::pair<simd_op, const char*> ops[] = {
+            {simd_op::sum, "sum"},     {simd_op::minmax, "minmax"},       {simd_op::dot, "dot"},
+            {simd_op::find, "find"},   {simd_op::count, "count"},         {simd_op::transform, "transform"},
+            {simd_op::inclusive_scan, "inclusive_scan"},
+        };
+        for (const auto& [op, op_name] : ops)
+        {
+            for (bool explicit_simd : {false, true})
+            {
+                const std::string name = std::string("simd_") + op_name + (explicit_simd ? "/myVector::simd/" : "/std/") + type_name;
+                benchmark::RegisterBenchmark(name.c_str(), [op, explicit_simd](benchmark::State& s) { simd_algorithm<T>(s, op, explicit_simd); })
+                    ->Arg(1 << 12)
+                    ->Arg(1 << 16)
+                    ->Arg(1 << 22);
+            }
+        }
+    }
+
+    void register_contiguous() {
+        const std::pair<contiguous_op, const char*> ops[] = {
+            {contiguous_op::copy, "std::copy"}, {contiguous_op::equal, "std::equal"}, {contiguous_op::construct, "my_vector(first, last)"}};
+        for (const auto& [op, op_name] : ops)
+        {
+            for (bool through_span : {false, true})
+            {
+                const std::string name = std::string("contiguous/") + op_name + (through_span ? "/std::span<int>" : "/my_vector<int>::iterator");
+                benchmark::RegisterBenchmark(name.c_str(), [op, through_span](benchmark::State& s) { contiguous_algorithm(s, op, through_span); })
+                    ->Arg(1 << 8)
+                    ->Arg(1 << 16)
+                    ->Arg(1 << 22);
+            }
+        }
+    }
+
+    template <typename Vector>
+    void register_element_access(const std::string& name) {
+        const std::pair<access_op, const char*> ops[] = {
+            {access_op::index, "operator[]"}, {access_op::iterate, "iterator"}, {access_op::back, "back+pop_back"}};
+        for (const auto& [op, op_name] : ops)
+        {
+            benchmark::RegisterBenchmark(("element_access/" + std::string(op_name) + "/" + name).c_str(),
+                                         [op](benchmark::State& s) { element_access<Vector>(s, op); })
+                ->Arg(1 << 10)
+                ->Arg(1 << 16);
+        }
+    }
+
+    void register_sort() {
+        const std::pair<sort_input, const char*> inputs[] = {
+            {sort_input::random, "random"}, {sort_input::sorted, "sorted"}, {sort_input::reversed, "reversed"}};
+        const std::pair<sort_algorithm, const char*> algorithms[] = {
+            {sort_algorithm::std_sort, "std::sort"},
+            {sort_algorithm::std_sort_par, "std::sort(par)"},
+            {sort_algorithm::parallel_sort, "parallel_sort"},
+            {sort_algorithm::parallel_sort_merge, "parallel_sort(lambda)"},
+            {sort_algorithm::parallel_stable_sort, "parallel_stable_sort"},
+        };
+        for (const auto& [input, input_name] : inputs)
+        {
+            for (const auto& [algorithm, algorithm_name] : algorithms)
+            {
+                const std::string name = std::string("sort/") + algorithm_name + "/" + input_name;
+                auto* b = benchmark::RegisterBenchmark(name.c_str(), [input, algorithm](benchmark::State& s) { sort_ints(s, input, algorithm); })
+                              ->ArgNames({"n", "threads"})
+                              ->Unit(benchmark::kMillisecond)
+                              ->UseRealTime();
+                const bool threaded = algorithm != sort_algorithm::std_sort && algorithm != sort_algorithm::std_sort_par;
+                for (std::int64_t threads = 1; threads <= (threaded ? 64 : 1); threads *= 2)
+                {
+                    b->Args({1 << 24, threads});
+                }
+            }
+        }
+    }
+
+    template <typename Array>
+    void register_array_scratch(const std::string& name) {
+        benchmark::RegisterBenchmark(("array_fill_zero/" + name).c_str(), [](benchmark::State& s) { array_fill<Array>(s, 0.0f); });
+        benchmark::RegisterBenchmark(("array_fill/" + name).c_str(), [](benchmark::State& s) { array_fill<Array>(s, 0.5f); });
+        benchmark::RegisterBenchmark(("array_swap/" + name).c_str(), array_swap<Array>);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    register_element<int>("int");
+    register_element<pod64>("pod64");
+    register_element<std::string>("std::string");
+    register_element<my_vector<int>>("my_vector<int>");
+    register_parallel<int>("int");
+    register_parallel<std::string>("std::string");
+    register_int_workloads<std::vector<int>>("std::vector<int>");
+    register_int_workloads<my_vector<int>>("my_vector<int>");
+    register_compare_1m<std::vector<int>>("std::vector<int>");
+    register_compare_1m<my_vector<int>>("my_vector<int>");
+    register_compare_1m<std::vector<double>>("std::vector<double>");
+    register_compare_1m<my_vector<double>>("my_vector<double>");
+    register_compare_1m<my_array<int, compare_size>>("my_array<int, 1M>");
+    benchmark::RegisterBenchmark("stream_sum_1g/my_vector<float>", stream_sum<my_vector<float>>)
+        ->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark("stream_sum_1g/my_vector<float, aligned_allocator<float, 64>>",
+                                 stream_sum<my_vector<float, myVector::aligned_allocator<float, 64>>>)
+        ->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark("stream_sum_1g/my_vector<float, huge_page_allocator<float>>",
+                                 stream_sum<my_vector<float, myVector::huge_page_allocator<float>>>)
+        ->Unit(benchmark::kMillisecond);
+    register_simd<int>("int");
+    register_simd<float>("float");
+    register_simd<double>("double");
+    register_array_scratch<std::array<float, 4096>>("std::array<float, 4096>");
+    register_array_scratch<my_array<float, 4096>>("my_array<float, 4096>");
+    register_contiguous();
+    register_element_access<std::vector<int>>("std::vector<int>");
+    register_element_access<my_vector<int>>("my_vector<int>");
+    register_sort();
+
+    const int max_threads = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+    benchmark::RegisterBenchmark("concurrent_push_back/concurrent_vector<int>", concurrent_push_back)
+        ->ThreadRange(1, max_threads)
+        ->Iterations(20)
+        ->UseRealTime();
+    benchmark::RegisterBenchmark("concurrent_push_back/mutex+my_vector<int>", locked_push_back)
+        ->ThreadRange(1, max_threads)
+        ->Iterations(20)
+        ->UseRealTime();
+
+    register_append_then_iterate<std::vector<heavy>>("std::vector<heavy>");
+    register_append_then_iterate<my_vector<heavy>>("my_vector<heavy>");
+    register_append_then_iterate<myVector::my_segmented_vector<heavy>>("my_segmented_vector<heavy>");
+
+    for (bool two_fields : {false, true})
+    {
+        const std::string fields = two_fields ? "price*quantity" : "price";
+        benchmark::RegisterBenchmark(("field_scan/my_vector<record>/" + fields).c_str(),
+                                     [two_fields](benchmark::State& s) { scan_aos(s, two_fields); })
+            ->Arg(1 << 20)
+            ->Arg(1 << 24);
+        benchmark::RegisterBenchmark(("field_scan/soa_vector<record fields>/" + fields).c_str(),
+                                     [two_fields](benchmark::State& s) { scan_soa(s, two_fields); })
+            ->Arg(1 << 20)
+            ->Arg(1 << 24);
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -1,4 +1,4 @@
-if (ENABLE_SANITIZERS OR ENABLE_UBSan OR ENABLE_MSAN OR ENABLE_ASAN OR ENABLE_TSan)
+if (ENABLE_SANITIZERS OR ENABLE_UBSan OR ENABLE_MSAN OR ENABLE_ASAN OR ENABLE_TSAN)
     message("- UCU.APPS.CS: Sanitizers enabled. You can disable it in CMakeLists.txt")
     if (CMAKE_C_COMPILER_ID STREQUAL "MSVC" OR CMAKE_CXX_COMPILER_ID STREQUAL "MSVC")
         message(WARNING "- UCU.APPS.CS: Sanitizers for the MSVC are not yet supported")
@@ -17,7 +17,7 @@ if (ENABLE_SANITIZERS OR ENABLE_UBSan OR ENABLE_MSAN OR ENABLE_ASAN OR ENABLE_TS
             elseif (ENABLE_ASAN)
                 message("- UCU.APPS.CS: ASAN Enabled in CMakeLists.txt")
                 set(SANITIZE_ADDRESS ON)
-            elseif (ENABLE_TSan)
+            elseif (ENABLE_TSAN)
                 message("- UCU.APPS.CS:  TSAN Enabled in CMakeLists.txt")
                 set(SANITIZE_THREAD ON)
             endif ()
@@ -27,7 +27,7 @@ if (ENABLE_SANITIZERS OR ENABLE_UBSan OR ENABLE_MSAN OR ENABLE_ASAN OR ENABLE_TS
             elseif (ENABLE_ASAN)
                 message("- UCU.APPS.CS: ASAN Enabled in CMakeLists.txt")
                 set(SANITIZE_ADDRESS ON)
-            elseif(ENABLE_TSan)
+            elseif(ENABLE_TSAN)
                 message("- UCU.APPS.CS: TSAN Enabled in CMakeLists.txt")
                 set(SANITIZE_THREAD ON)
             endif ()
@@ -0,0 +1,467 @@
+#ifndef CONCURRENT_VECTOR_H
+#define CONCURRENT_VECTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "my_vector.hpp"
+
+namespace myVector
+{
+    // Append-only vector for many producer threads. push_back, emplace_back and grow_by claim their
+    // indices with one atomic add and never move existing elements: storage is a list of segments
+    // of 8, 16, 32, ... elements, allocated once and kept until destruction, so element addresses
+    // are stable. Any thread may read element i (operator[], iterators) once the call that created
+    // it has returned and that is visible to the reader (e.g. the producer handed i over, or was
+    // joined). size() counts claimed indices, which can run ahead of the constructed elements.
+    // clear(), to_my_vector() and destruction need the appends to have finished.
+    // Allocator::allocate and deallocate get called from several threads at once.
+    template <typename T, typename Allocator = std::allocator<T>>
+    class concurrent_vector
+    {
+        using alloc_traits = std::allocator_traits<Allocator>;
+        static_assert(std::is_same_v<typename Allocator::value_type, T>,
+                      "concurrent_vector: Allocator::value_type must be T");
+
+        // segment allocations show up in my_vector_stats.hpp like my_vector's do
+        using instrumentation = vector_instrumentation<concurrent_vector>;
+
+      public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+
+        static constexpr size_type first_segment = 8;
+
+      private:
+        static constexpr size_type max_segments = std::numeric_limits<size_type>::digits - std::bit_width(first_segment);
+
+        [[no_unique_address]] allocator_type alloc_;
+        std::atomic<size_type>               size_{0};                // claimed indices
+        std::atomic<pointer>                 segments_[max_segments]{}; // null until first needed
+
+        // indices whose construction threw; rare, so a mutex is fine
+        mutable std::mutex                          holes_mutex_;
+        my_vector<std::pair<size_type, size_type>> holes_;
+        std::atomic<bool>                           has_holes_{false};
+
+        // Helper method declarations
+        static size_type segment_of(size_type index) noexcept;
+        static size_type segment_begin(size_type k) noexcept;
+        static size_type segment_size(size_type k) noexcept;
+        pointer          segment(size_type k);
+        pointer          slot(size_type index);
+        size_type        claim(size_type n);
+        void             mark_holes(size_type first, size_type last);
+        template <typename Visit>
+        void for_each_run(Visit visit) const;
+        template <typename HoleIt, typename Visit>
+        void for_each_run(HoleIt holes_first, HoleIt holes_last, Visit visit) const;
+        void destroy_all() noexcept;
+
+      public:
+        concurrent_vector() noexcept(noexcept(Allocator())) = default;
+        explicit concurrent_vector(const Allocator& alloc) noexcept;
+        concurrent_vector(const concurrent_vector&) = delete;
+        concurrent_vector& operator=(const concurrent_vector&) = delete;
+        ~concurrent_vector();
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept;
+
+        template <bool Const>
+        class base_iterator
+        {
+            using owner = std::conditional_t<Const, const concurrent_vector, concurrent_vector>;
+
+          public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const T*, T*>;
+            using reference = std::conditional_t<Const, const T&, T&>;
+
+            base_iterator() : owner_(nullptr), index_(0) {}
+            base_iterator(owner* vector, size_type index) : owner_(vector), index_(index) {}
+
+            template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+            base_iterator(const base_iterator<OtherConst>& other) : owner_(other.owner_), index_(other.index_) {}
+
+            reference operator*() const { return (*owner_)[index_]; }
+            pointer   operator->() const { return &(*owner_)[index_]; }
+
+            // clang-format off
+            base_iterator& operator++() { ++index_; return *this; }
+            base_iterator operator++(int) { base_iterator tmp = *this; ++index_; return tmp; }
+
+            base_iterator& operator--() { --index_; return *this; }
+            base_iterator operator--(int) { base_iterator tmp = *this; --index_; return tmp; }
+
+            base_iterator& operator+=(difference_type n) { index_ += n; return *this; }
+            base_iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+            // clang-format on
+
+            base_iterator operator+(difference_type n) const { return base_iterator(owner_, index_ + n); }
+            base_iterator operator-(difference_type n) const { return base_iterator(owner_, index_ - n); }
+            friend base_iterator operator+(difference_type n, const base_iterator& it) { return it + n; }
+
+            difference_type operator-(const base_iterator& other) const {
+                return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+            }
+
+            reference operator[](difference_type n) const { return (*owner_)[index_ + n]; }
+
+            bool operator==(const base_iterator& other) const { return index_ == other.index_; }
+            auto operator<=>(const base_iterator& other) const { return index_ <=> other.index_; }
+
+          private:
+            owner*    owner_;
+            size_type index_;
+
+            template <bool>
+            friend class base_iterator;
+        };
+
+        using iterator = base_iterator<false>;
+        using const_iterator = base_iterator<true>;
+
+        // Element access; i must name an element that is already constructed, see above
+        reference       operator[](size_type i);
+        const_reference operator[](size_type i) const;
+        reference       at(size_type i);
+        const_reference at(size_type i) const;
+
+        // Iterators over [0, size()) as of the call
+        iterator       begin() noexcept;
+        const_iterator begin() const noexcept;
+        const_iterator cbegin() const noexcept;
+        iterator       end() noexcept;
+        const_iterator end() const noexcept;
+        const_iterator cend() const noexcept;
+
+        // Capacity
+        [[nodiscard]] bool      is_empty() const noexcept;
+        [[nodiscard]] size_type size() const noexcept;
+        [[nodiscard]] size_type capacity() const noexcept;
+        [[nodiscard]] size_type max_size() const noexcept;
+
+        // Concurrent modifiers. If constructing an element throws, its index stays claimed but
+        // empty: iteration must not reach it, to_my_vector() and the destructor skip it.
+        iterator push_back(const T& value);
+        iterator push_back(T&& value);
+        template <typename... Args>
+        iterator emplace_back(Args&&... args);
+        // Appends n value-initialized elements (or copies of value) at consecutive indices
+        iterator grow_by(size_type n);
+        iterator grow_by(size_type n, const T& value);
+
+        // Not concurrent with anything else
+        void                                      clear() noexcept;
+        [[nodiscard]] my_vector<T, Allocator> to_my_vector() const;
+    };
+
+    template <typename T, typename Allocator>
+    concurrent_vector<T, Allocator>::concurrent_vector(const Allocator& alloc) noexcept : alloc_(alloc) {}
+
+    template <typename T, typename Allocator>
+    concurrent_vector<T, Allocator>::~concurrent_vector() {
+        destroy_all();
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::allocator_type concurrent_vector<T, Allocator>::get_allocator() const noexcept {
+        return alloc_;
+    }
+
+    // Segment k holds indices [8 * (2^k - 1), 8 * (2^(k+1) - 1))
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::segment_of(size_type index) noexcept {
+        return static_cast<size_type>(std::bit_width(index / first_segment + 1)) - 1;
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::segment_begin(size_type k) noexcept {
+        return first_segment * ((size_type{1} << k) - 1);
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::segment_size(size_type k) noexcept {
+        return first_segment << k;
+    }
+
+    // Whoever needs segment k first allocates it; when two threads race, the loser frees its copy
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::pointer concurrent_vector<T, Allocator>::segment(size_type k) {
+        pointer current = segments_[k].load(std::memory_order_acquire);
+        if (current == nullptr)
+        {
+            pointer fresh = alloc_traits::allocate(alloc_, segment_size(k));
+            if (segments_[k].compare_exchange_strong(current, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                instrumentation::on_allocate(segment_begin(k + 1), segment_size(k) * sizeof(T));
+                current = fresh;
+            } else {
+                alloc_traits::deallocate(alloc_, fresh, segment_size(k));
+            }
+        }
+        return current;
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::pointer concurrent_vector<T, Allocator>::slot(size_type index) {
+        const size_type k = segment_of(index);
+        return segment(k) + (index - segment_begin(k));
+    }
+
+    // Running out of segments would take more memory than exists, so only n itself is checked
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::claim(size_type n) {
+        if (n > max_size())
+        {
+            throw std::length_error("concurrent_vector: too many elements");
+        }
+        return size_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    template <typename T, typename Allocator>
+    void concurrent_vector<T, Allocator>::mark_holes(size_type first, size_type last) {
+        std::lock_guard<std::mutex> lock(holes_mutex_);
+        holes_.push_back({first, last});
+        has_holes_.store(true, std::memory_order_relaxed);
+    }
+
+    // Calls visit(ptr, count) for every run of constructed elements, in index order. Works on a
+    // sorted copy of the holes, so it leaves them alone for concurrent readers.
+    template <typename T, typename Allocator>
+    template <typename Visit>
+    void concurrent_vector<T, Allocator>::for_each_run(Visit visit) const {
+        my_vector<std::pair<size_type, size_type>> holes;
+        if (has_holes_.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(holes_mutex_);
+            holes = holes_;
+        }
+        std::sort(holes.begin(), holes.end());
+        for_each_run(holes.begin(), holes.end(), visit);
+    }
+
+    // Same walk over holes already sorted by the caller; allocates nothing
+    template <typename T, typename Allocator>
+    template <typename HoleIt, typename Visit>
+    void concurrent_vector<T, Allocator>::for_each_run(HoleIt holes_first, HoleIt holes_last, Visit visit) const {
+        const size_type n = size_.load(std::memory_order_acquire);
+        size_type       index = 0;
+        // the constructed run [index, end), cut at segment borders
+        auto visit_until = [&](size_type end) {
+            while (index < end)
+            {
+                const size_type k = segment_of(index);
+                const size_type run_end = std::min(end, segment_begin(k + 1));
+                visit(segments_[k].load(std::memory_order_acquire) + (index - segment_begin(k)), run_end - index);
+                index = run_end;
+            }
+        };
+        for (; holes_first != holes_last; ++holes_first)
+        {
+            const auto& [hole_first, hole_last] = *holes_first;
+            visit_until(hole_first);
+            index = std::max(index, hole_last);
+        }
+        visit_until(n);
+    }
+
+    template <typename T, typename Allocator>
+    void concurrent_vector<T, Allocator>::destroy_all() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            // sorted in place: copying the holes could throw, and this runs from the destructor
+            std::lock_guard<std::mutex> lock(holes_mutex_);
+            std::sort(holes_.begin(), holes_.end());
+            for_each_run(holes_.begin(), holes_.end(), [&](pointer first, size_type count) {
+                for (pointer p = first; p != first + count; ++p)
+                {
+                    alloc_traits::destroy(alloc_, p);
+                }
+            });
+        }
+        for (size_type k = 0; k < max_segments; ++k)
+        {
+            if (pointer p = segments_[k].exchange(nullptr, std::memory_order_acq_rel))
+            {
+                alloc_traits::deallocate(alloc_, p, segment_size(k));
+                instrumentation::on_deallocate();
+            }
+        }
+        size_.store(0, std::memory_order_relaxed);
+        holes_.clear();
+        has_holes_.store(false, std::memory_order_relaxed);
+    }
+
+    // Element access
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::reference concurrent_vector<T, Allocator>::operator[](size_type i) {
+        const size_type k = segment_of(i);
+        return segments_[k].load(std::memory_order_acquire)[i - segment_begin(k)];
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::const_reference concurrent_vector<T, Allocator>::operator[](size_type i) const {
+        const size_type k = segment_of(i);
+        return segments_[k].load(std::memory_order_acquire)[i - segment_begin(k)];
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::reference concurrent_vector<T, Allocator>::at(size_type i) {
+        if (i >= size())
+        {
+            throw std::out_of_range("concurrent_vector::at: index out of range");
+        }
+        return (*this)[i];
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::const_reference concurrent_vector<T, Allocator>::at(size_type i) const {
+        if (i >= size())
+        {
+            throw std::out_of_range("concurrent_vector::at: index out of range");
+        }
+        return (*this)[i];
+    }
+
+    // Iterators
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::iterator concurrent_vector<T, Allocator>::begin() noexcept {
+        return iterator(this, 0);
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::const_iterator concurrent_vector<T, Allocator>::begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::const_iterator concurrent_vector<T, Allocator>::cbegin() const noexcept {
+        return begin();
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::iterator concurrent_vector<T, Allocator>::end() noexcept {
+        return iterator(this, size());
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::const_iterator concurrent_vector<T, Allocator>::end() const noexcept {
+        return const_iterator(this, size());
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::const_iterator concurrent_vector<T, Allocator>::cend() const noexcept {
+        return end();
+    }
+
+    // Capacity
+    template <typename T, typename Allocator>
+    bool concurrent_vector<T, Allocator>::is_empty() const noexcept {
+        return size() == 0;
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::size() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    // Indices that fit the segments allocated so far
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::capacity() const noexcept {
+        size_type k = 0;
+        while (k < max_segments && segments_[k].load(std::memory_order_acquire) != nullptr)
+        {
+            ++k;
+        }
+        return segment_begin(k);
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::max_size() const noexcept {
+        return std::min<size_type>(segment_begin(max_segments), alloc_traits::max_size(alloc_));
+    }
+
+    // Concurrent modifiers
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::iterator concurrent_vector<T, Allocator>::push_back(const T& value) {
+        return emplace_back(value);
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::iterator concurrent_vector<T, Allocator>::push_back(T&& value) {
+        return emplace_back(std::move(value));
+    }
+
+    template <typename T, typename Allocator>
+    template <typename... Args>
+    typename concurrent_vector<T, Allocator>::iterator concurrent_vector<T, Allocator>::emplace_back(Args&&... args) {
+        const size_type index = claim(1);
+        try
+        {
+            alloc_traits::construct(alloc_, slot(index), std::forward<Args>(args)...);
+        } catch (...)
+        {
+            mark_holes(index, index + 1);
+            throw;
+        }
+        return iterator(this, index);
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::iterator concurrent_vector<T, Allocator>::grow_by(size_type n) {
+        return grow_by(n, T());
+    }
+
+    template <typename T, typename Allocator>
+    typename concurrent_vector<T, Allocator>::iterator concurrent_vector<T, Allocator>::grow_by(size_type n, const T& value) {
+        const size_type first = claim(n);
+        size_type index = first;
+        try
+        {
+            for (; index < first + n; ++index)
+            {
+                alloc_traits::construct(alloc_, slot(index), value);
+            }
+        } catch (...)
+        {
+            // what was built stays, the rest of the claimed range is empty
+            mark_holes(index, first + n);
+            throw;
+        }
+        return iterator(this, first);
+    }
+
+    template <typename T, typename Allocator>
+    void concurrent_vector<T, Allocator>::clear() noexcept {
+        destroy_all();
+    }
+
+    // Contiguous copy of the constructed elements in index order, one memcpy per run when T allows
+    template <typename T, typename Allocator>
+    my_vector<T, Allocator> concurrent_vector<T, Allocator>::to_my_vector() const {
+        my_vector<T, Allocator> result(alloc_traits::select_on_container_copy_construction(alloc_));
+        result.reserve(size());
+        for_each_run([&](const_pointer first, size_type count) { result.append(first, first + count); });
+        return result;
+    }
+}; // namespace myVector
+
+#endif // CONCURRENT_VECTOR_H
@@ -3,10 +3,17 @@
 #include <string>
 #include <chrono>
 #include <vector>
+#include <fstream>
+#include <numeric>
 
 
 #include "my_vector.hpp"
 #include "my_array.hpp"
+#include "my_allocators.hpp"
+#if defined(__linux__)
+#include "mmap_vector.hpp"
+#endif
+#include "options_parser.h"
 
 using namespace std::chrono;
 using myVector::my_vector;
@@ -21,44 +28,104 @@ long long time_us(F&& fn) {
     return duration_cast<microseconds>(t1 - t0).count();
 }
 
-int main() {
-
-    constexpr size_t N = 10'000'000;
+// peak resident set size (VmHWM) in KiB, 0 where /proc is not available
+long long peak_rss_kb() {
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    while (status >> key) {
+        if (key == "VmHWM:") {
+            long long kb = 0;
+            status >> kb;
+            return kb;
+        }
+    }
+    return 0;
+}
 
-    // 1) push-back comparioson
-    std::vector<int>     std_v; std_v.reserve(N);
-    my_vector<int>       my_v;  my_v.reserve(N);
+// writing 5 to clear_refs resets VmHWM to the current RSS (Linux only)
+void reset_peak_rss() {
+    std::ofstream("/proc/self/clear_refs") << "5";
+}
 
-    auto std_push_us = time_us([&](){
-        for(size_t i = 0; i < N; ++i) std_v.push_back(int(i));
-    });
-    auto my_push_us  = time_us([&](){
-        for(size_t i = 0; i < N; ++i) my_v.push_back(int(i));
+// grows a vector to n ints and reports time and the peak RSS it caused
+template<typename Vector>
+void growth_run(const char* name, size_t n, bool with_reserve) {
+    reset_peak_rss();
+    long long before = peak_rss_kb();
+    auto us = time_us([&](){
+        Vector v;
+        if (with_reserve) v.reserve(n);
+        for (size_t i = 0; i < n; ++i) v.push_back(int(i));
     });
+    std::cout << name << (with_reserve ? " +reserve" : "         ")
+              << ": " << us / 1000 << " ms, peak RSS +" << (peak_rss_kb() - before) / 1024 << " MiB\n";
+}
 
-    // 2) copy-construction
-    auto std_copy_us = time_us([&](){
-        std::vector<int> copy(std_v);
-        (void)copy;
-    });
-    auto my_copy_us  = time_us([&](){
-        my_vector<int> copy(my_v);
-        (void)copy;
+// appends n ints, counts reallocations and reports the unused tail left at the end
+template<typename Policy>
+void growth_policy_run(const char* name, size_t n) {
+    size_t reallocations = 0;
+    size_t slack = 0;
+    auto us = time_us([&](){
+        my_vector<int, std::allocator<int>, Policy> v;
+        for (size_t i = 0; i < n; ++i) {
+            if (v.size() == v.capacity()) ++reallocations;
+            v.push_back(int(i));
+        }
+        slack = v.capacity() - v.size();
     });
+    std::cout << name << ": " << us / 1000 << " ms, " << reallocations << " reallocations, slack "
+              << slack * sizeof(int) / 1024 << " KiB\n";
+}
 
-    // 3) iteration
-    volatile long long std_sum = 0, my_sum = 0;  // volatile
-    auto my_iter_us  = time_us([&](){
-        for(auto x : my_v)  my_sum  += x;
-    });
-    auto std_iter_us = time_us([&](){
-        for(auto x : std_v) std_sum += x;
-    });
+// maps each file as raw ints and sums it, without reading it into memory first
+int sum_files(const std::vector<std::string>& filenames) {
+    for (const auto& name : filenames) {
+        try {
+            assert_file_exist(name);
+#if defined(__linux__)
+            myVector::mmap_vector<int> ints(name, myVector::mmap_mode::read_only);
+            long long sum = 0;
+            auto us = time_us([&](){ sum = std::accumulate(ints.begin(), ints.end(), 0LL); });
+            std::cout << name << ": " << ints.size() << " ints, sum " << sum << " (" << us << " µs)\n";
+#else
+            throw std::runtime_error("mmap_vector is only available on Linux");
+#endif
+        } catch (const std::exception& ex) {
+            std::cerr << name << ": " << ex.what() << '\n';
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    // ./StdVectorArray <file1> ... sums files of raw ints through mmap_vector
+    command_line_options_t options(argc, argv);
+    if (!options.get_filenames().empty()) {
+        return sum_files(options.get_filenames());
+    }
+
+    constexpr size_t N = 10'000'000;
+
+    // timing of the individual operations lives in StdVectorArray_bench (benchmarks/benchmarks.cpp);
+    // the runs below report memory behaviour, which a benchmark loop can't show
+
+    // 1) growing to 100M ints: operator new + copy vs realloc/mremap
+    constexpr size_t growth_N = 100'000'000;
+    for (bool with_reserve : {false, true}) {
+        growth_run<std::vector<int>>("std::vector             ", growth_N, with_reserve);
+        growth_run<my_vector<int>>("my_vector               ", growth_N, with_reserve);
+        growth_run<my_vector<int, myVector::realloc_allocator<int>>>("my_vector<realloc_alloc>", growth_N, with_reserve);
+    }
 
-    std::cout
-        << "push-back: std=" << std_push_us << "µs, my=" << my_push_us  << " µs\n"
-        << "copy-ctor: std=" << std_copy_us << "µs, my=" << my_copy_us  << " µs\n"
-        << "iteration: std=" << std_iter_us << "µs, my=" << my_iter_us  << " µs\n";
+    // 2) growth policies on N push-backs without reserve
+    growth_policy_run<myVector::default_growth>("1.5x          ", N);
+    growth_policy_run<myVector::double_growth>("2x            ", N);
+    growth_policy_run<myVector::gentle_growth>("1.25x         ", N);
+    growth_policy_run<myVector::page_rounded_growth<>>("1.25x + pages ", N);
+    growth_policy_run<myVector::size_class_growth<>>("1.5x + malloc ", N);
+    growth_policy_run<myVector::chunk_growth<(1 << 22)>>("+4 MiB chunks ", N);
 
 
     // worked hah, im happy. auto-destroy
@@ -88,7 +155,8 @@ int main() {
     auto x1 = ms[1];
     std::cout << x0 << ',' << x1 << '\n';    // "hi!,bye!"
 
-    my_array<my_array<int, 5>, 5>;
+    my_array<my_array<int, 5>, 5> nested{};
+    (void)nested;
 
     return 0;
 }
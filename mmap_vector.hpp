@@ -0,0 +1,702 @@
+#ifndef MMAP_VECTOR_H
+#define MMAP_VECTOR_H
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if !defined(__linux__)
+#error "mmap_vector grows its mapping with mremap, which is Linux-only"
+#endif
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "my_growth_policies.hpp"
+#include "my_vector.hpp"
+
+namespace myVector
+{
+    enum class mmap_mode
+    {
+        read_write, // MAP_SHARED: changes reach the file, growth extends it
+        read_only   // MAP_PRIVATE: elements may be changed in memory, the file never is
+    };
+
+    // my_vector whose buffer is a memory-mapped file holding the raw elements, so a table written
+    // once can be opened again without reading or copying it. Growth extends the file with
+    // ftruncate and the mapping with mremap. While open for writing the file is as long as the
+    // capacity; close() (or the destructor) trims it back to size() elements.
+    template <typename T, typename GrowthPolicy = page_rounded_growth<default_growth>>
+    class mmap_vector
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "mmap_vector: elements are stored as raw bytes");
+
+        using heap_vector = my_vector<T>;
+
+      public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+
+        using iterator = typename heap_vector::iterator;
+        using const_iterator = typename heap_vector::const_iterator;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+      private:
+        pointer     data_;     // start of the mapping, nullptr while nothing is mapped
+        size_type   size_;     // number of elements
+        size_type   capacity_; // elements the mapping (and the file) can hold
+        int         fd_;       // -1 when closed
+        mmap_mode   mode_;
+        std::string path_;
+
+        // Helper method declarations
+        void ensure_open() const;
+        void ensure_writable() const;
+        void remap(size_type new_capacity);
+        template <typename Fill>
+        void emplace_gap(size_type index, size_type count, Fill&& fill);
+        [[nodiscard]] size_type calculate_growth(size_type new_size) const;
+        [[noreturn]] static void throw_errno(const char* what, const std::string& path);
+
+      public:
+        // Constructor declarations
+        mmap_vector() noexcept;
+        explicit mmap_vector(const std::string& path, mmap_mode mode = mmap_mode::read_write);
+        mmap_vector(const mmap_vector&) = delete;
+        mmap_vector(mmap_vector&& other) noexcept;
+
+        // Destructor declaration
+        ~mmap_vector();
+
+        // Operator declarations
+        mmap_vector& operator=(const mmap_vector&) = delete;
+        mmap_vector& operator=(mmap_vector&& other) noexcept;
+
+        // File
+        void open(const std::string& path, mmap_mode mode = mmap_mode::read_write);
+        void flush();
+        void close();
+        [[nodiscard]] bool               is_open() const noexcept;
+        [[nodiscard]] bool               is_read_only() const noexcept;
+        [[nodiscard]] const std::string& path() const noexcept;
+
+        // Element access
+        reference       operator[](size_type pos);
+        const_reference operator[](size_type pos) const;
+        reference       at(size_type pos);
+        const_reference at(size_type pos) const;
+        reference       front();
+        const_reference front() const;
+        reference       back();
+        const_reference back() const;
+        pointer         data() noexcept;
+        const_pointer   data() const noexcept;
+
+        // Capacity
+        [[nodiscard]] bool      is_empty() const noexcept;
+        [[nodiscard]] size_type size() const noexcept;
+        [[nodiscard]] size_type max_size() const noexcept;
+        void                    reserve(size_type new_cap);
+        [[nodiscard]] size_type capacity() const noexcept;
+        void                    shrink_to_fit();
+
+        // Modifiers
+        void clear() noexcept;
+        void push_back(const T& value);
+        template <typename... Args>
+        reference emplace_back(Args&&... args);
+        void      pop_back();
+        void      resize(size_type new_size);
+        void      resize(size_type new_size, const T& value);
+        void      assign(size_type n, const T& value);
+        template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        void assign(InputIt first, InputIt last);
+        void assign(std::initializer_list<T> ilist);
+        void swap(mmap_vector& other) noexcept;
+
+        // Comparison operators
+        bool operator==(const mmap_vector& other) const;
+        auto operator<=>(const mmap_vector& other) const;
+
+        // Iterators
+        iterator               begin() noexcept;
+        const_iterator         begin() const noexcept;
+        const_iterator         cbegin() const noexcept;
+        iterator               end() noexcept;
+        const_iterator         end() const noexcept;
+        const_iterator         cend() const noexcept;
+        reverse_iterator       rbegin() noexcept;
+        const_reverse_iterator rbegin() const noexcept;
+        const_reverse_iterator crbegin() const noexcept;
+        reverse_iterator       rend() noexcept;
+        const_reverse_iterator rend() const noexcept;
+        const_reverse_iterator crend() const noexcept;
+
+        // Modifiers
+        iterator insert(const_iterator pos, const T& value);
+        iterator insert(const_iterator pos, size_type n, const T& value);
+        template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        iterator insert(const_iterator pos, InputIt first, InputIt last);
+        iterator insert(const_iterator pos, std::initializer_list<T> ilist);
+        iterator erase(const_iterator pos);
+        iterator erase(const_iterator first, const_iterator last);
+    };
+
+    // Constructor implementations
+    template <typename T, typename GrowthPolicy>
+    mmap_vector<T, GrowthPolicy>::mmap_vector() noexcept :
+        data_(nullptr), size_(0), capacity_(0), fd_(-1), mode_(mmap_mode::read_write) {}
+
+    template <typename T, typename GrowthPolicy>
+    mmap_vector<T, GrowthPolicy>::mmap_vector(const std::string& path, mmap_mode mode) : mmap_vector() {
+        open(path, mode);
+    }
+
+    template <typename T, typename GrowthPolicy>
+    mmap_vector<T, GrowthPolicy>::mmap_vector(mmap_vector&& other) noexcept : mmap_vector() {
+        swap(other);
+    }
+
+    // Destructor implementation
+    template <typename T, typename GrowthPolicy>
+    mmap_vector<T, GrowthPolicy>::~mmap_vector() {
+        try
+        {
+            close();
+        } catch (...)
+        {
+            // the mapping and the descriptor are released either way, only the trim failed
+        }
+    }
+
+    template <typename T, typename GrowthPolicy>
+    mmap_vector<T, GrowthPolicy>& mmap_vector<T, GrowthPolicy>::operator=(mmap_vector&& other) noexcept {
+        if (this != &other)
+        {
+            mmap_vector tmp(std::move(other));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    // File implementations
+    // Maps the whole file; its length must be a whole number of elements
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::open(const std::string& path, mmap_mode mode) {
+        close();
+
+        const bool writable = mode == mmap_mode::read_write;
+        int fd = ::open(path.c_str(), writable ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+        if (fd < 0)
+        {
+            throw_errno("mmap_vector::open", path);
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0)
+        {
+            int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "mmap_vector::open: " + path);
+        }
+        const auto bytes = static_cast<size_type>(st.st_size);
+        if (bytes % sizeof(T) != 0)
+        {
+            ::close(fd);
+            throw std::invalid_argument("mmap_vector::open: " + path + " is not a whole number of elements");
+        }
+
+        void* mapped = nullptr;
+        if (bytes > 0)
+        {
+            mapped = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, writable ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED)
+            {
+                int err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::generic_category(), "mmap_vector::open: " + path);
+            }
+        }
+
+        data_ = static_cast<pointer>(mapped);
+        size_ = bytes / sizeof(T);
+        capacity_ = size_;
+        fd_ = fd;
+        mode_ = mode;
+        path_ = path;
+    }
+
+    // Writes the dirty pages back; the file stays capacity() elements long until close()
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::flush() {
+        ensure_open();
+        if (mode_ == mmap_mode::read_write && data_ != nullptr && ::msync(data_, capacity_ * sizeof(T), MS_SYNC) != 0)
+        {
+            throw_errno("mmap_vector::flush", path_);
+        }
+    }
+
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::close() {
+        if (fd_ < 0)
+        {
+            return;
+        }
+
+        if (data_ != nullptr)
+        {
+            ::munmap(data_, capacity_ * sizeof(T));
+        }
+        const bool trim = mode_ == mmap_mode::read_write && size_ != capacity_;
+        const int fd = fd_;
+        const off_t bytes = static_cast<off_t>(size_ * sizeof(T));
+
+        data_ = nullptr;
+        size_ = 0;
+        capacity_ = 0;
+        fd_ = -1;
+
+        int err = trim && ::ftruncate(fd, bytes) != 0 ? errno : 0;
+        ::close(fd);
+        if (err != 0)
+        {
+            throw std::system_error(err, std::generic_category(), "mmap_vector::close: " + path_);
+        }
+    }
+
+    template <typename T, typename GrowthPolicy>
+    bool mmap_vector<T, GrowthPolicy>::is_open() const noexcept {
+        return fd_ >= 0;
+    }
+
+    template <typename T, typename GrowthPolicy>
+    bool mmap_vector<T, GrowthPolicy>::is_read_only() const noexcept {
+        return mode_ == mmap_mode::read_only;
+    }
+
+    template <typename T, typename GrowthPolicy>
+    const std::string& mmap_vector<T, GrowthPolicy>::path() const noexcept {
+        return path_;
+    }
+
+    // Element access implementations
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::reference mmap_vector<T, GrowthPolicy>::operator[](size_type pos) {
+        return data_[pos];
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::const_reference mmap_vector<T, GrowthPolicy>::operator[](size_type pos) const {
+        return data_[pos];
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::reference mmap_vector<T, GrowthPolicy>::at(size_type pos) {
+        if (pos >= size_)
+        {
+            throw std::out_of_range("mmap_vector::at: index out of range");
+        }
+        return data_[pos];
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::const_reference mmap_vector<T, GrowthPolicy>::at(size_type pos) const {
+        if (pos >= size_)
+        {
+            throw std::out_of_range("mmap_vector::at: index out of range");
+        }
+        return data_[pos];
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::reference mmap_vector<T, GrowthPolicy>::front() {
+        return data_[0];
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::const_reference mmap_vector<T, GrowthPolicy>::front() const {
+        return data_[0];
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::reference mmap_vector<T, GrowthPolicy>::back() {
+        return data_[size_ - 1];
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::const_reference mmap_vector<T, GrowthPolicy>::back() const {
+        return data_[size_ - 1];
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::pointer mmap_vector<T, GrowthPolicy>::data() noexcept {
+        return data_;
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::const_pointer mmap_vector<T, GrowthPolicy>::data() const noexcept {
+        return data_;
+    }
+
+    // Capacity implementations
+    template <typename T, typename GrowthPolicy>
+    bool mmap_vector<T, GrowthPolicy>::is_empty() const noexcept {
+        return size_ == 0;
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::size_type mmap_vector<T, GrowthPolicy>::size() const noexcept {
+        return size_;
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::size_type mmap_vector<T, GrowthPolicy>::max_size() const noexcept {
+        return static_cast<size_type>(std::numeric_limits<off_t>::max()) / sizeof(T);
+    }
+
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::reserve(size_type new_cap) {
+        if (new_cap > capacity_)
+        {
+            if (new_cap > max_size())
+            {
+                throw std::length_error("mmap_vector::reserve: capacity exceeds max_size()");
+            }
+            remap(new_cap);
+        }
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::size_type mmap_vector<T, GrowthPolicy>::capacity() const noexcept {
+        return capacity_;
+    }
+
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::shrink_to_fit() {
+        if (size_ < capacity_)
+        {
+            remap(size_);
+        }
+    }
+
+    // Modifier implementations
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::clear() noexcept {
+        size_ = 0;
+    }
+
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    template <typename T, typename GrowthPolicy>
+    template <typename... Args>
+    typename mmap_vector<T, GrowthPolicy>::reference mmap_vector<T, GrowthPolicy>::emplace_back(Args&&... args) {
+        if (size_ == capacity_)
+        {
+            T value(std::forward<Args>(args)...); // args may refer into the mapping that is about to move
+            remap(calculate_growth(size_ + 1));
+            ::new (static_cast<void*>(data_ + size_)) T(value);
+        } else {
+            ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+        }
+        return data_[size_++];
+    }
+
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::pop_back() {
+        if (size_ > 0)
+        {
+            --size_;
+        }
+    }
+
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::resize(size_type new_size) {
+        resize(new_size, T());
+    }
+
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::resize(size_type new_size, const T& value) {
+        if (new_size > size_)
+        {
+            insert(cend(), new_size - size_, value);
+        } else {
+            size_ = new_size;
+        }
+    }
+
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::assign(size_type n, const T& value) {
+        clear();
+        insert(cend(), n, value);
+    }
+
+    template <typename T, typename GrowthPolicy>
+    template <typename InputIt, typename>
+    void mmap_vector<T, GrowthPolicy>::assign(InputIt first, InputIt last) {
+        clear();
+        insert(cend(), first, last);
+    }
+
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::assign(std::initializer_list<T> ilist) {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::swap(mmap_vector& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(fd_, other.fd_);
+        std::swap(mode_, other.mode_);
+        std::swap(path_, other.path_);
+    }
+
+    // Comparison operators, same ordering as my_vector: shorter sorts first
+    template <typename T, typename GrowthPolicy>
+    bool mmap_vector<T, GrowthPolicy>::operator==(const mmap_vector& other) const {
+        return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+    }
+
+    template <typename T, typename GrowthPolicy>
+    auto mmap_vector<T, GrowthPolicy>::operator<=>(const mmap_vector& other) const {
+        using ordering = std::common_comparison_category_t<std::compare_three_way_result_t<T>, std::strong_ordering>;
+        if (size_ != other.size_)
+        {
+            return static_cast<ordering>(size_ <=> other.size_);
+        }
+        return static_cast<ordering>(std::lexicographical_compare_three_way(begin(), end(), other.begin(), other.end()));
+    }
+
+    // Iterator implementations
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::iterator mmap_vector<T, GrowthPolicy>::begin() noexcept {
+        return iterator(data_);
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::const_iterator mmap_vector<T, GrowthPolicy>::begin() const noexcept {
+        return const_iterator(data_);
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::const_iterator mmap_vector<T, GrowthPolicy>::cbegin() const noexcept {
+        return const_iterator(data_);
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::iterator mmap_vector<T, GrowthPolicy>::end() noexcept {
+        return iterator(data_ + size_);
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::const_iterator mmap_vector<T, GrowthPolicy>::end() const noexcept {
+        return const_iterator(data_ + size_);
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::const_iterator mmap_vector<T, GrowthPolicy>::cend() const noexcept {
+        return const_iterator(data_ + size_);
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::reverse_iterator mmap_vector<T, GrowthPolicy>::rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::const_reverse_iterator mmap_vector<T, GrowthPolicy>::rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::const_reverse_iterator mmap_vector<T, GrowthPolicy>::crbegin() const noexcept {
+        return const_reverse_iterator(cend());
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::reverse_iterator mmap_vector<T, GrowthPolicy>::rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::const_reverse_iterator mmap_vector<T, GrowthPolicy>::rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::const_reverse_iterator mmap_vector<T, GrowthPolicy>::crend() const noexcept {
+        return const_reverse_iterator(cbegin());
+    }
+
+    // Insert/erase implementations; elements are raw bytes, so every shift is one memmove
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::iterator mmap_vector<T, GrowthPolicy>::insert(const_iterator pos, const T& value) {
+        return insert(pos, 1, value);
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::iterator mmap_vector<T, GrowthPolicy>::insert(const_iterator pos, size_type n, const T& value) {
+        size_type index = pos - cbegin();
+        const T copy = value;
+        emplace_gap(index, n, [&](pointer gap) { std::fill_n(gap, n, copy); });
+        return begin() + index;
+    }
+
+    template <typename T, typename GrowthPolicy>
+    template <typename InputIt, typename>
+    typename mmap_vector<T, GrowthPolicy>::iterator mmap_vector<T, GrowthPolicy>::insert(const_iterator pos, InputIt first, InputIt last) {
+        size_type index = pos - cbegin();
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+        {
+            auto count = static_cast<size_type>(std::distance(first, last));
+            emplace_gap(index, count, [&](pointer gap) { std::copy_n(first, count, gap); });
+        } else {
+            // single pass: append, then rotate the new tail into place
+            size_type old_size = size_;
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+            std::rotate(data_ + index, data_ + old_size, data_ + size_);
+        }
+        return begin() + index;
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::iterator mmap_vector<T, GrowthPolicy>::insert(const_iterator pos,
+                                                                                         std::initializer_list<T> ilist) {
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::iterator mmap_vector<T, GrowthPolicy>::erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::iterator mmap_vector<T, GrowthPolicy>::erase(const_iterator first, const_iterator last) {
+        size_type index_first = first - cbegin();
+        size_type index_last = last - cbegin();
+        if (index_last > index_first)
+        {
+            std::memmove(data_ + index_first, data_ + index_last, (size_ - index_last) * sizeof(T));
+            size_ -= index_last - index_first;
+        }
+        return begin() + index_first;
+    }
+
+    // Helper method implementations
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::ensure_open() const {
+        if (fd_ < 0)
+        {
+            throw std::logic_error("mmap_vector: no file is open");
+        }
+    }
+
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::ensure_writable() const {
+        ensure_open();
+        if (mode_ == mmap_mode::read_only)
+        {
+            throw std::logic_error("mmap_vector: a read-only mapping can't change the file size");
+        }
+    }
+
+    // Resizes the file to new_capacity elements and the mapping with it
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::remap(size_type new_capacity) {
+        ensure_writable();
+
+        const size_type old_bytes = capacity_ * sizeof(T);
+        const size_type new_bytes = new_capacity * sizeof(T);
+        if (new_bytes > old_bytes && ::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0)
+        {
+            throw_errno("mmap_vector: growing", path_);
+        }
+
+        void* mapped = nullptr;
+        if (data_ == nullptr)
+        {
+            mapped = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        } else if (new_bytes == 0)
+        {
+            ::munmap(data_, old_bytes);
+        } else {
+            mapped = ::mremap(data_, old_bytes, new_bytes, MREMAP_MAYMOVE);
+        }
+        if (mapped == MAP_FAILED)
+        {
+            int err = errno;
+            if (new_bytes > old_bytes)
+            {
+                (void)::ftruncate(fd_, static_cast<off_t>(old_bytes)); // the old mapping is still intact
+            }
+            throw std::system_error(err, std::generic_category(), "mmap_vector: mapping " + path_);
+        }
+        if (new_bytes < old_bytes && ::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0)
+        {
+            throw_errno("mmap_vector: shrinking", path_);
+        }
+
+        data_ = static_cast<pointer>(mapped);
+        capacity_ = new_capacity;
+    }
+
+    // Opens count slots at index (growing first if needed), then lets fill write them
+    template <typename T, typename GrowthPolicy>
+    template <typename Fill>
+    void mmap_vector<T, GrowthPolicy>::emplace_gap(size_type index, size_type count, Fill&& fill) {
+        if (count == 0)
+        {
+            return;
+        }
+        if (count > capacity_ - size_)
+        {
+            remap(calculate_growth(size_ + count));
+        }
+        std::memmove(data_ + index + count, data_ + index, (size_ - index) * sizeof(T));
+        fill(data_ + index);
+        size_ += count;
+    }
+
+    template <typename T, typename GrowthPolicy>
+    typename mmap_vector<T, GrowthPolicy>::size_type mmap_vector<T, GrowthPolicy>::calculate_growth(size_type new_size) const {
+        const size_type max_sz = max_size();
+        if (new_size > max_sz)
+        {
+            throw std::length_error("mmap_vector::calculate_growth: maximum size exceeded");
+        }
+        return std::clamp(GrowthPolicy::template next_capacity<T>(capacity_, new_size), new_size, max_sz);
+    }
+
+    template <typename T, typename GrowthPolicy>
+    void mmap_vector<T, GrowthPolicy>::throw_errno(const char* what, const std::string& path) {
+        throw std::system_error(errno, std::generic_category(), std::string(what) + ": " + path);
+    }
+}; // namespace myVector
+
+#endif // MMAP_VECTOR_H
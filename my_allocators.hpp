@@ -0,0 +1,284 @@
+#ifndef MY_ALLOCATORS_H
+#define MY_ALLOCATORS_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace myVector
+{
+    // Allocator that can grow a block without copying it, for trivially relocatable payloads.
+    // Blocks below MmapThreshold bytes live on the malloc heap and grow with realloc,
+    // larger ones are anonymous mappings that grow with mremap, so the kernel moves page
+    // table entries instead of bytes. my_vector uses reallocate() automatically.
+    template <typename T, std::size_t MmapThreshold = std::size_t{1} << 20>
+    struct realloc_allocator
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "realloc_allocator: over-aligned types are not supported");
+
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = realloc_allocator<U, MmapThreshold>;
+        };
+
+        realloc_allocator() noexcept = default;
+        template <typename U>
+        realloc_allocator(const realloc_allocator<U, MmapThreshold>&) noexcept {}
+
+        T*   allocate(std::size_t n);
+        void deallocate(T* ptr, std::size_t n) noexcept;
+        T*   reallocate(T* ptr, std::size_t old_n, std::size_t new_n);
+
+        friend bool operator==(const realloc_allocator&, const realloc_allocator&) noexcept { return true; }
+
+      private:
+        static bool        is_mapped(std::size_t n) noexcept;
+        static std::size_t mapping_size(std::size_t n) noexcept;
+    };
+
+    template <typename T, std::size_t MmapThreshold>
+    T* realloc_allocator<T, MmapThreshold>::allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+
+#if defined(__linux__)
+        if (is_mapped(n))
+        {
+            void* ptr = mmap(nullptr, mapping_size(n), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr == MAP_FAILED)
+            {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(ptr);
+        }
+#endif
+
+        void* ptr = std::malloc(n * sizeof(T));
+        if (ptr == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    template <typename T, std::size_t MmapThreshold>
+    void realloc_allocator<T, MmapThreshold>::deallocate(T* ptr, std::size_t n) noexcept {
+#if defined(__linux__)
+        if (is_mapped(n))
+        {
+            munmap(ptr, mapping_size(n));
+            return;
+        }
+#endif
+        std::free(ptr);
+    }
+
+    // The bytes of the old block end up at the start of the new one. Crossing the threshold
+    // changes the kind of block, which is the only case that costs a copy.
+    template <typename T, std::size_t MmapThreshold>
+    T* realloc_allocator<T, MmapThreshold>::reallocate(T* ptr, std::size_t old_n, std::size_t new_n) {
+        const bool was_mapped = is_mapped(old_n);
+        const bool mapped = is_mapped(new_n);
+
+#if defined(__linux__)
+        if (was_mapped && mapped)
+        {
+            void* moved = mremap(ptr, mapping_size(old_n), mapping_size(new_n), MREMAP_MAYMOVE);
+            if (moved == MAP_FAILED)
+            {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(moved);
+        }
+#endif
+
+        if (!was_mapped && !mapped)
+        {
+            void* moved = std::realloc(ptr, new_n * sizeof(T));
+            if (moved == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(moved);
+        }
+
+        T* fresh = allocate(new_n);
+        std::memcpy(static_cast<void*>(fresh), static_cast<const void*>(ptr), std::min(old_n, new_n) * sizeof(T));
+        deallocate(ptr, old_n);
+        return fresh;
+    }
+
+    template <typename T, std::size_t MmapThreshold>
+    bool realloc_allocator<T, MmapThreshold>::is_mapped(std::size_t n) noexcept {
+#if defined(__linux__)
+        return n * sizeof(T) >= MmapThreshold;
+#else
+        return false;
+#endif
+    }
+
+    template <typename T, std::size_t MmapThreshold>
+    std::size_t realloc_allocator<T, MmapThreshold>::mapping_size(std::size_t n) noexcept {
+#if defined(__linux__)
+        static const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        return (n * sizeof(T) + page - 1) / page * page;
+#else
+        return n * sizeof(T);
+#endif
+    }
+
+    // Allocator for SIMD-friendly buffers: every block starts on an Alignment boundary
+    // (64 = one cache line = one AVX-512 register), through the aligned operator new.
+    template <typename T, std::size_t Alignment = 64>
+    struct aligned_allocator
+    {
+        static_assert(std::has_single_bit(Alignment) && Alignment >= alignof(T), "aligned_allocator: bad alignment");
+
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = aligned_allocator<U, std::max(Alignment, alignof(U))>;
+        };
+
+        aligned_allocator() noexcept = default;
+        template <typename U, std::size_t A>
+        aligned_allocator(const aligned_allocator<U, A>&) noexcept {}
+
+        T* allocate(std::size_t n) {
+            if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+        }
+
+        void deallocate(T* ptr, std::size_t n) noexcept { ::operator delete(ptr, n * sizeof(T), std::align_val_t{Alignment}); }
+
+        friend bool operator==(const aligned_allocator&, const aligned_allocator&) noexcept { return true; }
+    };
+
+    // Allocator for big streaming buffers. Blocks of at least HugeThreshold bytes are mapped in
+    // whole 2 MiB huge pages, so a 1 GiB buffer needs 512 TLB entries instead of 262144:
+    // first from the hugetlbfs pool (MAP_HUGETLB), and when that has no pages reserved, as an
+    // ordinary mapping aligned to 2 MiB and marked MADV_HUGEPAGE for transparent huge pages.
+    // Smaller blocks come from aligned_allocator<T, Alignment>.
+    template <typename T, std::size_t HugeThreshold = std::size_t{2} << 20, std::size_t Alignment = 64>
+    struct huge_page_allocator
+    {
+        static constexpr std::size_t huge_page_size = std::size_t{2} << 20;
+
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = huge_page_allocator<U, HugeThreshold, std::max(Alignment, alignof(U))>;
+        };
+
+        huge_page_allocator() noexcept = default;
+        template <typename U, std::size_t A>
+        huge_page_allocator(const huge_page_allocator<U, HugeThreshold, A>&) noexcept {}
+
+        T*   allocate(std::size_t n);
+        void deallocate(T* ptr, std::size_t n) noexcept;
+
+        friend bool operator==(const huge_page_allocator&, const huge_page_allocator&) noexcept { return true; }
+
+      private:
+        static bool        is_mapped(std::size_t n) noexcept;
+        static std::size_t mapping_size(std::size_t n) noexcept;
+
+        [[no_unique_address]] aligned_allocator<T, Alignment> small_;
+    };
+
+    template <typename T, std::size_t HugeThreshold, std::size_t Alignment>
+    T* huge_page_allocator<T, HugeThreshold, Alignment>::allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+
+#if defined(__linux__)
+        if (is_mapped(n))
+        {
+            const std::size_t size = mapping_size(n);
+            void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (ptr != MAP_FAILED)
+            {
+                return static_cast<T*>(ptr);
+            }
+
+            // over-map by one huge page and trim, so the block starts on a huge page boundary
+            void* raw = mmap(nullptr, size + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED)
+            {
+                throw std::bad_alloc();
+            }
+            auto* first = static_cast<unsigned char*>(raw);
+            auto* aligned = reinterpret_cast<unsigned char*>((reinterpret_cast<std::uintptr_t>(first) + huge_page_size - 1) &
+                                                             ~(huge_page_size - 1));
+            if (aligned != first)
+            {
+                munmap(first, static_cast<std::size_t>(aligned - first));
+            }
+            munmap(aligned + size, static_cast<std::size_t>(first + huge_page_size - aligned));
+#if defined(MADV_HUGEPAGE)
+            madvise(aligned, size, MADV_HUGEPAGE); // only a hint, the block works without it
+#endif
+            return reinterpret_cast<T*>(aligned);
+        }
+#endif
+
+        return small_.allocate(n);
+    }
+
+    template <typename T, std::size_t HugeThreshold, std::size_t Alignment>
+    void huge_page_allocator<T, HugeThreshold, Alignment>::deallocate(T* ptr, std::size_t n) noexcept {
+#if defined(__linux__)
+        if (is_mapped(n))
+        {
+            munmap(ptr, mapping_size(n));
+            return;
+        }
+#endif
+        small_.deallocate(ptr, n);
+    }
+
+    template <typename T, std::size_t HugeThreshold, std::size_t Alignment>
+    bool huge_page_allocator<T, HugeThreshold, Alignment>::is_mapped(std::size_t n) noexcept {
+#if defined(__linux__)
+        return n * sizeof(T) >= HugeThreshold;
+#else
+        return false;
+#endif
+    }
+
+    // both kinds of mapping are released with this length, so it is a whole number of huge pages
+    template <typename T, std::size_t HugeThreshold, std::size_t Alignment>
+    std::size_t huge_page_allocator<T, HugeThreshold, Alignment>::mapping_size(std::size_t n) noexcept {
+        return (n * sizeof(T) + huge_page_size - 1) / huge_page_size * huge_page_size;
+    }
+}; // namespace myVector
+
+#endif // MY_ALLOCATORS_H
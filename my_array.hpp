@@ -11,6 +11,10 @@
 #include <array>          // std::array
 #include <concepts>       // std::convertible_to
 #include <initializer_list> // std::initializer_list
+#include <algorithm>      // std::equal, std::lexicographical_compare_three_way, std::fill_n, std::swap_ranges
+#include <cstring>        // std::memcpy, std::memset
+
+#include "my_compare.hpp"
 
 // implementation does not use dynamic memory allocation
 // There are no calls to new/malloc under the hood
@@ -26,8 +30,7 @@ struct my_array {
     // initializer-list constructor
     constexpr my_array(std::initializer_list<T> il) {
         if (il.size() != N) throw std::length_error("my_array initializer_list size mismatch");
-        std::size_t i = 0;
-        for (auto& v : il) elems[i++] = v;
+        copy_from(il.begin());
     }
 
     // converting constructor from std::array<U, N>
@@ -35,8 +38,7 @@ struct my_array {
     constexpr my_array(const std::array<U, N>& other)
         noexcept(noexcept(T(std::declval<U>())))
     {
-        for (std::size_t i = 0; i < N; ++i)
-            elems[i] = other[i];
+        copy_from(other.data());
     }
 
     // defaulted special members
@@ -52,8 +54,7 @@ struct my_array {
     constexpr my_array& operator=(const std::array<U, N>& other)
         noexcept(noexcept(elems[0] = other[0]))
     {
-        for (std::size_t i = 0; i < N; ++i)
-            elems[i] = other[i];
+        copy_from(other.data());
         return *this;
     }
 
@@ -84,16 +85,48 @@ struct my_array {
     constexpr bool empty() const noexcept { return N == 0; }
 
     // modifiers
+    // trivially copyable values made of one repeated byte (0, -1, 0.0f, nullptr...) are a memset,
+    // other trivially copyable ones a std::fill_n the compiler vectorizes
     constexpr void fill(const T& value)
         noexcept(noexcept(std::declval<T&>() = value))
     {
+        if !consteval {
+            if constexpr (std::is_trivially_copyable_v<T> && N > 0) {
+                unsigned char bytes[sizeof(T)];
+                std::memcpy(bytes, &value, sizeof(T));
+                bool repeated = true;
+                for (std::size_t i = 1; i < sizeof(T); ++i) repeated &= bytes[i] == bytes[0];
+                if (repeated) std::memset(elems, bytes[0], sizeof(elems));
+                else std::fill_n(elems, N, value);
+                return;
+            }
+        }
         for (auto& e : elems) e = value;
     }
+    // trivially copyable elements trade places through a small stack buffer, block by block
     constexpr void swap(my_array& other)
         noexcept(noexcept(std::swap(std::declval<T&>(), std::declval<T&>())))
     {
-        for (std::size_t i=0; i<N; ++i)
-            std::swap(elems[i], other.elems[i]);
+        if !consteval {
+            if constexpr (std::is_trivially_copyable_v<T> && N > 0) {
+                if (this == &other) return;
+                constexpr std::size_t block = 256;
+                auto* a = reinterpret_cast<unsigned char*>(elems);
+                auto* b = reinterpret_cast<unsigned char*>(other.elems);
+                unsigned char tmp[block];
+                std::size_t i = 0;
+                for (; i + block <= sizeof(elems); i += block) {
+                    std::memcpy(tmp, a + i, block);
+                    std::memcpy(a + i, b + i, block);
+                    std::memcpy(b + i, tmp, block);
+                }
+                std::memcpy(tmp, a + i, sizeof(elems) - i);
+                std::memcpy(a + i, b + i, sizeof(elems) - i);
+                std::memcpy(b + i, tmp, sizeof(elems) - i);
+                return;
+            }
+        }
+        std::swap_ranges(elems, elems + N, other.elems);
     }
 
     // iteration
@@ -101,20 +134,38 @@ struct my_array {
     constexpr const T* begin() const noexcept          { return elems; }
     constexpr       T* end() noexcept                  { return elems + N; }
     constexpr const T* end() const noexcept            { return elems + N; }
-    constexpr       T* cbegin() const noexcept         { return elems; }
-    constexpr       T* cend()   const noexcept         { return elems + N; }
+    constexpr const T* cbegin() const noexcept         { return elems; }
+    constexpr const T* cend()   const noexcept         { return elems + N; }
     constexpr auto rbegin() noexcept                   { return std::reverse_iterator(end()); }
     constexpr auto rend() noexcept                     { return std::reverse_iterator(begin()); }
     constexpr auto crbegin() const noexcept            { return std::reverse_iterator(cend()); }
     constexpr auto crend()   const noexcept            { return std::reverse_iterator(cbegin()); }
 
-    // comparisons
-    constexpr auto operator<=>(my_array const&) const
-        noexcept(noexcept(std::declval<T>() <=> std::declval<T>()))
-        = default;
-    constexpr bool operator==(my_array const&) const
-        noexcept(noexcept(std::declval<T>() == std::declval<T>()))
-        = default;
+    // comparisons, same results as the defaulted ones but memcmp/SIMD at run time (my_compare.hpp)
+    constexpr auto operator<=>(my_array const& other) const requires std::three_way_comparable<T>
+    {
+        if consteval { return std::lexicographical_compare_three_way(elems, elems + N, other.elems, other.elems + N); }
+        return myVector::compare_elements(elems, other.elems, N);
+    }
+    constexpr bool operator==(my_array const& other) const requires std::equality_comparable<T>
+    {
+        if consteval { return std::equal(elems, elems + N, other.elems); }
+        return myVector::equal_elements(elems, other.elems, N);
+    }
+
+private:
+    // elems[i] = src[i]; one memcpy when U is T and trivially copyable
+    template<typename U>
+    constexpr void copy_from(const U* src) {
+        if !consteval {
+            if constexpr (std::is_same_v<std::remove_cv_t<U>, T> && std::is_trivially_copyable_v<T> && N > 0) {
+                std::memcpy(elems, src, sizeof(elems));
+                return;
+            }
+        }
+        for (std::size_t i = 0; i < N; ++i)
+            elems[i] = src[i];
+    }
 };
 
 // ADL‑friendly swap
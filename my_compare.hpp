@@ -0,0 +1,210 @@
+#ifndef MY_COMPARE_H
+#define MY_COMPARE_H
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define MY_COMPARE_X86 1
+#endif
+
+// Element-range comparisons behind my_vector's and my_array's == and <=>.
+// Types whose equality is plain byte equality (integers, enums, pointers) compare with memcmp
+// and find their first difference 32 (AVX2) or 16 (SSE2) bytes at a time; float and double use
+// the vector float compares, so NaN != NaN and -0.0 == 0.0 still hold. AVX2 is picked at run
+// time. Every other type falls back to the element-wise loop.
+
+namespace myVector
+{
+    template <typename T>
+    inline constexpr bool is_bitwise_comparable_v =
+        (std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>) && std::has_unique_object_representations_v<T>;
+
+    template <typename T>
+    using element_ordering_t = std::common_comparison_category_t<std::compare_three_way_result_t<T>, std::strong_ordering>;
+
+    namespace detail
+    {
+        // index of the first differing byte, or n
+        inline std::size_t mismatch_bytes_scalar(const unsigned char* a, const unsigned char* b, std::size_t n) noexcept {
+            std::size_t i = 0;
+            for (; i + sizeof(std::uint64_t) <= n; i += sizeof(std::uint64_t))
+            {
+                std::uint64_t x, y;
+                std::memcpy(&x, a + i, sizeof(x));
+                std::memcpy(&y, b + i, sizeof(y));
+                if (x != y)
+                {
+                    if constexpr (std::endian::native == std::endian::little)
+                    {
+                        return i + static_cast<std::size_t>(std::countr_zero(x ^ y)) / 8;
+                    } else {
+                        return i + static_cast<std::size_t>(std::countl_zero(x ^ y)) / 8;
+                    }
+                }
+            }
+            for (; i < n && a[i] == b[i]; ++i)
+            {}
+            return i;
+        }
+
+        // index of the first element that doesn't compare equal, or n
+        template <typename F>
+        std::size_t mismatch_float_scalar(const F* a, const F* b, std::size_t i, std::size_t n) noexcept {
+            for (; i < n && a[i] == b[i]; ++i)
+            {}
+            return i;
+        }
+
+#if defined(MY_COMPARE_X86)
+        inline std::size_t mismatch_bytes_sse2(const unsigned char* a, const unsigned char* b, std::size_t n) noexcept {
+            std::size_t i = 0;
+            for (; i + 16 <= n; i += 16)
+            {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+                __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+                auto equal = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+                if (equal != 0xFFFFu)
+                {
+                    return i + static_cast<std::size_t>(std::countr_zero(~equal));
+                }
+            }
+            return i + mismatch_bytes_scalar(a + i, b + i, n - i);
+        }
+
+        __attribute__((target("avx2"))) inline std::size_t mismatch_bytes_avx2(const unsigned char* a, const unsigned char* b,
+                                                                               std::size_t n) noexcept {
+            std::size_t i = 0;
+            for (; i + 32 <= n; i += 32)
+            {
+                __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+                auto equal = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+                if (equal != 0xFFFFFFFFu)
+                {
+                    return i + static_cast<std::size_t>(std::countr_zero(~equal));
+                }
+            }
+            return i + mismatch_bytes_scalar(a + i, b + i, n - i);
+        }
+
+        template <typename F>
+        std::size_t mismatch_float_sse2(const F* a, const F* b, std::size_t n) noexcept {
+            constexpr std::size_t lanes = 16 / sizeof(F);
+            constexpr unsigned all = (1u << lanes) - 1;
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes)
+            {
+                unsigned equal;
+                if constexpr (std::is_same_v<F, float>)
+                {
+                    equal = static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i))));
+                } else {
+                    equal = static_cast<unsigned>(_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i))));
+                }
+                if (equal != all)
+                {
+                    return i + static_cast<std::size_t>(std::countr_zero(~equal));
+                }
+            }
+            return mismatch_float_scalar(a, b, i, n);
+        }
+
+        template <typename F>
+        __attribute__((target("avx2"))) std::size_t mismatch_float_avx2(const F* a, const F* b, std::size_t n) noexcept {
+            constexpr std::size_t lanes = 32 / sizeof(F);
+            constexpr unsigned all = (1u << lanes) - 1;
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes)
+            {
+                unsigned equal;
+                if constexpr (std::is_same_v<F, float>)
+                {
+                    equal = static_cast<unsigned>(
+                        _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), _CMP_EQ_OQ)));
+                } else {
+                    equal = static_cast<unsigned>(
+                        _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), _CMP_EQ_OQ)));
+                }
+                if (equal != all)
+                {
+                    return i + static_cast<std::size_t>(std::countr_zero(~equal));
+                }
+            }
+            return mismatch_float_scalar(a, b, i, n);
+        }
+
+        inline bool has_avx2() noexcept {
+            static const bool supported = __builtin_cpu_supports("avx2");
+            return supported;
+        }
+#endif
+
+        inline std::size_t mismatch_bytes(const unsigned char* a, const unsigned char* b, std::size_t n) noexcept {
+#if defined(MY_COMPARE_X86)
+            return has_avx2() ? mismatch_bytes_avx2(a, b, n) : mismatch_bytes_sse2(a, b, n);
+#else
+            return mismatch_bytes_scalar(a, b, n);
+#endif
+        }
+
+        template <typename F>
+        std::size_t mismatch_float(const F* a, const F* b, std::size_t n) noexcept {
+#if defined(MY_COMPARE_X86)
+            return has_avx2() ? mismatch_float_avx2(a, b, n) : mismatch_float_sse2(a, b, n);
+#else
+            return mismatch_float_scalar(a, b, 0, n);
+#endif
+        }
+    } // namespace detail
+
+    // Index of the first position where a and b differ, or n
+    template <typename T>
+    std::size_t mismatch_index(const T* a, const T* b, std::size_t n) {
+        if constexpr (is_bitwise_comparable_v<T>)
+        {
+            return detail::mismatch_bytes(reinterpret_cast<const unsigned char*>(a), reinterpret_cast<const unsigned char*>(b),
+                                          n * sizeof(T)) /
+                   sizeof(T);
+        } else if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+        {
+            return detail::mismatch_float(a, b, n);
+        } else {
+            return static_cast<std::size_t>(std::mismatch(a, a + n, b).first - a);
+        }
+    }
+
+    // a[0, n) == b[0, n)
+    template <typename T>
+    bool equal_elements(const T* a, const T* b, std::size_t n) {
+        if constexpr (is_bitwise_comparable_v<T>)
+        {
+            return n == 0 || std::memcmp(a, b, n * sizeof(T)) == 0;
+        } else if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+        {
+            return mismatch_index(a, b, n) == n;
+        } else {
+            return std::equal(a, a + n, b);
+        }
+    }
+
+    // Lexicographic a[0, n) <=> b[0, n): jump to the first difference, compare just that element
+    template <typename T>
+    element_ordering_t<T> compare_elements(const T* a, const T* b, std::size_t n) {
+        if constexpr (is_bitwise_comparable_v<T> || std::is_same_v<T, float> || std::is_same_v<T, double>)
+        {
+            std::size_t i = mismatch_index(a, b, n);
+            return i == n ? element_ordering_t<T>(std::strong_ordering::equal) : element_ordering_t<T>(a[i] <=> b[i]);
+        } else {
+            return std::lexicographical_compare_three_way(a, a + n, b, b + n);
+        }
+    }
+}; // namespace myVector
+
+#endif // MY_COMPARE_H
@@ -0,0 +1,99 @@
+#ifndef MY_GROWTH_POLICIES_H
+#define MY_GROWTH_POLICIES_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+// Growth policies decide the capacity my_vector asks for when it runs out of room.
+// A policy is any type with
+//     template <typename T> static std::size_t next_capacity(std::size_t capacity, std::size_t required);
+// The result must be >= required; my_vector clamps it to max_size() afterwards.
+
+namespace myVector
+{
+    // capacity * Num / Den, saturating instead of overflowing
+    template <std::size_t Num, std::size_t Den>
+    struct growth_factor
+    {
+        static_assert(Den > 0 && Num > Den, "growth_factor: the factor must be greater than 1");
+
+        template <typename T>
+        static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required) noexcept {
+            constexpr std::size_t max = std::numeric_limits<std::size_t>::max();
+            std::size_t grown = capacity / Den > max / Num ? max : capacity / Den * Num + capacity % Den * Num / Den;
+            return std::max(grown, required);
+        }
+    };
+
+    using default_growth = growth_factor<3, 2>; // what my_vector always did
+    using double_growth = growth_factor<2, 1>;  // fewer reallocations for append-heavy workloads
+    using gentle_growth = growth_factor<5, 4>;  // less slack for memory-tight caches
+
+    // Adds a fixed number of bytes per step: linear growth for huge buffers
+    template <std::size_t ChunkBytes>
+    struct chunk_growth
+    {
+        template <typename T>
+        static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required) noexcept {
+            constexpr std::size_t chunk = std::max<std::size_t>(1, ChunkBytes / sizeof(T));
+            std::size_t grown = capacity > std::numeric_limits<std::size_t>::max() - chunk ? required : capacity + chunk;
+            return std::max(grown, required);
+        }
+    };
+
+    // Rounds the buffer of Base up to whole pages
+    template <typename Base = gentle_growth, std::size_t PageSize = 4096>
+    struct page_rounded_growth
+    {
+        template <typename T>
+        static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required) noexcept {
+            std::size_t elements = Base::template next_capacity<T>(capacity, required);
+            if (elements > (std::numeric_limits<std::size_t>::max() - PageSize) / sizeof(T))
+            {
+                return elements;
+            }
+            std::size_t bytes = (elements * sizeof(T) + PageSize - 1) / PageSize * PageSize;
+            return bytes / sizeof(T);
+        }
+    };
+
+    // Rounds the buffer of Base up to the chunk glibc malloc would hand back anyway
+    // (what malloc_usable_size reports), so the slack at the end becomes usable capacity.
+    // Small requests land in 16-byte size classes with 8 bytes of header,
+    // requests past the mmap threshold get whole pages minus a 16-byte header.
+    template <typename Base = default_growth>
+    struct size_class_growth
+    {
+        static constexpr std::size_t usable_size(std::size_t bytes) noexcept {
+            constexpr std::size_t header = sizeof(std::size_t);
+            constexpr std::size_t align = 2 * sizeof(std::size_t);
+            constexpr std::size_t min_chunk = 4 * sizeof(std::size_t);
+            constexpr std::size_t mmap_threshold = 128 * 1024;
+            constexpr std::size_t page = 4096;
+
+            if (bytes > std::numeric_limits<std::size_t>::max() - 2 * page)
+            {
+                return bytes;
+            }
+            if (bytes + header >= mmap_threshold)
+            {
+                return (bytes + 2 * header + page - 1) / page * page - 2 * header;
+            }
+            std::size_t chunk = std::max(min_chunk, (bytes + header + align - 1) & ~(align - 1));
+            return chunk - header;
+        }
+
+        template <typename T>
+        static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required) noexcept {
+            std::size_t elements = Base::template next_capacity<T>(capacity, required);
+            if (elements > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            {
+                return elements;
+            }
+            return std::max(elements, usable_size(elements * sizeof(T)) / sizeof(T));
+        }
+    };
+}; // namespace myVector
+
+#endif // MY_GROWTH_POLICIES_H
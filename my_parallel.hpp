@@ -0,0 +1,173 @@
+#ifndef MY_PARALLEL_H
+#define MY_PARALLEL_H
+
+// Execution-policy support for my_vector's bulk construction (my_vector(std::execution::par, ...),
+// assign(par, ...), resize(par, ...)). Work is split into page-sized chunks that run on one shared
+// pool of worker threads plus the calling thread. The buffer is allocated without being touched,
+// so on NUMA machines every page lands on the node of the thread that constructs into it first.
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <execution>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace myVector
+{
+    template <typename Policy>
+    concept execution_policy = std::is_execution_policy_v<std::remove_cvref_t<Policy>>;
+
+    // Below this many bytes the thread hand-off costs more than it saves
+    inline std::atomic<std::size_t> parallel_threshold_bytes{std::size_t{4} << 20};
+
+    template <execution_policy Policy>
+    bool parallel_worthwhile(std::size_t bytes) noexcept {
+        return !std::is_same_v<std::remove_cvref_t<Policy>, std::execution::sequenced_policy> &&
+               bytes >= parallel_threshold_bytes.load(std::memory_order_relaxed);
+    }
+
+    class thread_pool
+    {
+      public:
+        // Never destroyed, the workers stay parked until the process exits
+        static thread_pool& instance();
+
+        // Worker threads plus the caller
+        [[nodiscard]] std::size_t concurrency() const noexcept { return workers_.size() + 1; }
+
+        // Calls task(i) for every i in [0, count) and returns once all of them finished.
+        // The exception a task threw is kept at its index, the others are null.
+        template <typename Task>
+        std::vector<std::exception_ptr> run(std::size_t count, Task&& task);
+
+      private:
+        struct batch
+        {
+            batch(std::size_t count, std::function<void(std::size_t)> task);
+            void work() noexcept;
+            void wait();
+
+            std::function<void(std::size_t)> task;
+            std::size_t                      count;
+            std::atomic<std::size_t>         next{0};
+            std::size_t                      done = 0;
+            std::vector<std::exception_ptr>  errors;
+            std::mutex                       mutex;
+            std::condition_variable          finished;
+        };
+
+        explicit thread_pool(std::size_t workers);
+        void worker_loop();
+
+        std::mutex                        mutex_;
+        std::condition_variable           wake_;
+        std::deque<std::function<void()>> queue_;
+        std::vector<std::thread>          workers_;
+    };
+
+    // How a range of n elements is cut: `count` chunks of `chunk` elements, the last one shorter
+    struct chunk_plan
+    {
+        std::size_t chunk;
+        std::size_t count;
+    };
+
+    // A few chunks per thread so a slow one doesn't hold everybody up, each a whole number of pages
+    inline chunk_plan plan_chunks(std::size_t n, std::size_t element_size) {
+        constexpr std::size_t page_size = 4096;
+        const std::size_t per_page = std::max<std::size_t>(1, page_size / element_size);
+        const std::size_t wanted = thread_pool::instance().concurrency() * 4;
+        std::size_t chunk = (n + wanted - 1) / wanted;
+        chunk = (chunk + per_page - 1) / per_page * per_page;
+        return {chunk, n == 0 ? 0 : (n + chunk - 1) / chunk};
+    }
+
+    template <typename Task>
+    std::vector<std::exception_ptr> thread_pool::run(std::size_t count, Task&& task) {
+        if (count == 0)
+        {
+            return {};
+        }
+
+        // shared, because helpers may get dequeued after the batch is over and find nothing to do
+        auto state = std::make_shared<batch>(count, std::function<void(std::size_t)>(std::ref(task)));
+        const std::size_t helpers = std::min(workers_.size(), count - 1);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (std::size_t i = 0; i < helpers; ++i)
+            {
+                queue_.emplace_back([state] { state->work(); });
+            }
+        }
+        wake_.notify_all();
+
+        state->work();
+        state->wait();
+        return std::move(state->errors);
+    }
+
+    inline thread_pool::batch::batch(std::size_t count, std::function<void(std::size_t)> task) :
+        task(std::move(task)), count(count), errors(count) {}
+
+    inline void thread_pool::batch::work() noexcept {
+        for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1))
+        {
+            try
+            {
+                task(i);
+            } catch (...)
+            {
+                errors[i] = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (++done == count)
+            {
+                finished.notify_all();
+            }
+        }
+    }
+
+    inline void thread_pool::batch::wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return done == count; });
+    }
+
+    inline thread_pool& thread_pool::instance() {
+        static thread_pool* pool = new thread_pool(std::max(2u, std::thread::hardware_concurrency()) - 1);
+        return *pool;
+    }
+
+    inline thread_pool::thread_pool(std::size_t workers) {
+        workers_.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i)
+        {
+            workers_.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    inline void thread_pool::worker_loop() {
+        for (;;)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [this] { return !queue_.empty(); });
+                job = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            job();
+        }
+    }
+}; // namespace myVector
+
+#endif // MY_PARALLEL_H
@@ -0,0 +1,654 @@
+#ifndef MY_SEGMENTED_VECTOR_H
+#define MY_SEGMENTED_VECTOR_H
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "my_compare.hpp"
+#include "my_vector.hpp"
+
+namespace myVector
+{
+    // Vector whose elements never move. Storage is a table of blocks of 16, 32, 64, ... elements;
+    // growing adds a block and leaves the old ones alone, so pointers, references and iterators
+    // stay valid across push_back (only removing the element itself invalidates them). Element i
+    // lives in block log2(i + 16) - 4, found with one countl_zero, so operator[] is two loads.
+    template <typename T, typename Allocator = std::allocator<T>>
+    class my_segmented_vector
+    {
+        using alloc_traits = std::allocator_traits<Allocator>;
+        static_assert(std::is_same_v<typename Allocator::value_type, T>,
+                      "my_segmented_vector: Allocator::value_type must be T");
+
+        // no-ops unless MY_VECTOR_INSTRUMENTATION is set, see my_vector_stats.hpp
+        using instrumentation = vector_instrumentation<my_segmented_vector>;
+
+      public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+
+        static constexpr size_type first_block = 16;
+
+      private:
+        static constexpr int first_block_bits = std::countr_zero(first_block);
+
+        [[no_unique_address]] allocator_type alloc_;  // where the blocks come from
+        my_vector<pointer>                   blocks_; // block k holds block_size(k) elements
+        size_type                            size_;   // number of elements
+
+        // Helper method declarations
+        static size_type block_of(size_type index) noexcept;
+        static size_type block_begin(size_type k) noexcept;
+        static size_type block_size(size_type k) noexcept;
+        pointer          address(size_type index) const noexcept;
+        void             add_block();
+        void             destroy_from(size_type new_size) noexcept;
+        void             release_blocks(size_type keep) noexcept;
+        template <typename Visit>
+        void for_each_run(size_type first, size_type last, Visit visit) const;
+
+      public:
+        template <bool Const>
+        class base_iterator
+        {
+            using owner = std::conditional_t<Const, const my_segmented_vector, my_segmented_vector>;
+
+          public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const T*, T*>;
+            using reference = std::conditional_t<Const, const T&, T&>;
+
+            base_iterator() : owner_(nullptr), index_(0), ptr_(nullptr) {}
+            base_iterator(owner* vector, size_type index) : owner_(vector), index_(index), ptr_(vector->address(index)) {}
+
+            template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+            base_iterator(const base_iterator<OtherConst>& other) :
+                owner_(other.owner_), index_(other.index_), ptr_(other.ptr_) {}
+
+            reference operator*() const { return *ptr_; }
+            pointer   operator->() const { return ptr_; }
+
+            // stepping stays inside the current block except at its first/last element
+            base_iterator& operator++() {
+                ++index_;
+                ptr_ = std::has_single_bit(index_ + first_block) ? owner_->address(index_) : ptr_ + 1;
+                return *this;
+            }
+            base_iterator& operator--() {
+                ptr_ = std::has_single_bit(index_ + first_block) ? owner_->address(index_ - 1) : ptr_ - 1;
+                --index_;
+                return *this;
+            }
+
+            // clang-format off
+            base_iterator operator++(int) { base_iterator tmp = *this; ++*this; return tmp; }
+            base_iterator operator--(int) { base_iterator tmp = *this; --*this; return tmp; }
+
+            base_iterator& operator+=(difference_type n) { *this = base_iterator(owner_, index_ + static_cast<size_type>(n)); return *this; }
+            base_iterator& operator-=(difference_type n) { return *this += -n; }
+            // clang-format on
+
+            base_iterator operator+(difference_type n) const { return base_iterator(*this) += n; }
+            base_iterator operator-(difference_type n) const { return base_iterator(*this) -= n; }
+            friend base_iterator operator+(difference_type n, const base_iterator& it) { return it + n; }
+
+            difference_type operator-(const base_iterator& other) const {
+                return static_cast<difference_type>(index_ - other.index_);
+            }
+
+            reference operator[](difference_type n) const { return *(*this + n); }
+
+            bool operator==(const base_iterator& other) const { return index_ == other.index_; }
+            auto operator<=>(const base_iterator& other) const { return index_ <=> other.index_; }
+
+          private:
+            owner*    owner_;
+            size_type index_;
+            pointer   ptr_; // null past the last allocated block
+
+            template <bool>
+            friend class base_iterator;
+        };
+
+        using iterator = base_iterator<false>;
+        using const_iterator = base_iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        // Constructor declarations
+        my_segmented_vector() noexcept(noexcept(Allocator()));
+        explicit my_segmented_vector(const Allocator& alloc) noexcept;
+        explicit my_segmented_vector(size_type n, const T& value = T(), const Allocator& alloc = Allocator());
+        template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        my_segmented_vector(InputIt first, InputIt last, const Allocator& alloc = Allocator());
+        my_segmented_vector(std::initializer_list<T> init, const Allocator& alloc = Allocator());
+        my_segmented_vector(const my_segmented_vector& other);
+        my_segmented_vector(my_segmented_vector&& other) noexcept;
+        ~my_segmented_vector();
+
+        my_segmented_vector& operator=(const my_segmented_vector& other);
+        my_segmented_vector& operator=(my_segmented_vector&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                                                             alloc_traits::is_always_equal::value);
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept;
+
+        // Element access
+        reference       operator[](size_type pos);
+        const_reference operator[](size_type pos) const;
+        reference       at(size_type pos);
+        const_reference at(size_type pos) const;
+        reference       front();
+        const_reference front() const;
+        reference       back();
+        const_reference back() const;
+
+        // Iterators
+        iterator               begin() noexcept;
+        const_iterator         begin() const noexcept;
+        const_iterator         cbegin() const noexcept;
+        iterator               end() noexcept;
+        const_iterator         end() const noexcept;
+        const_iterator         cend() const noexcept;
+        reverse_iterator       rbegin() noexcept;
+        const_reverse_iterator rbegin() const noexcept;
+        reverse_iterator       rend() noexcept;
+        const_reverse_iterator rend() const noexcept;
+
+        // Capacity
+        [[nodiscard]] bool      is_empty() const noexcept;
+        [[nodiscard]] size_type size() const noexcept;
+        [[nodiscard]] size_type max_size() const noexcept;
+        [[nodiscard]] size_type capacity() const noexcept;
+        void                    reserve(size_type new_cap);
+        void                    shrink_to_fit() noexcept;
+
+        // Modifiers
+        void clear() noexcept;
+        void push_back(const T& value);
+        void push_back(T&& value);
+        template <typename... Args>
+        reference emplace_back(Args&&... args);
+        void      pop_back();
+        void      resize(size_type new_size);
+        void      resize(size_type new_size, const T& value);
+        void      swap(my_segmented_vector& other) noexcept;
+
+        // Contiguous copy, one append per block
+        [[nodiscard]] my_vector<T, Allocator> to_my_vector() const;
+
+        // Comparison operators
+        bool operator==(const my_segmented_vector& other) const;
+        auto operator<=>(const my_segmented_vector& other) const;
+    };
+
+    // Block k holds indices [16 * (2^k - 1), 16 * (2^(k+1) - 1)), i.e. index + 16 has its top bit at k + 4
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::size_type my_segmented_vector<T, Allocator>::block_of(size_type index) noexcept {
+        return static_cast<size_type>(std::numeric_limits<size_type>::digits - 1 - first_block_bits -
+                                      std::countl_zero(index + first_block));
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::size_type my_segmented_vector<T, Allocator>::block_begin(size_type k) noexcept {
+        return (first_block << k) - first_block;
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::size_type my_segmented_vector<T, Allocator>::block_size(size_type k) noexcept {
+        return first_block << k;
+    }
+
+    // Null when the index is past the allocated blocks (end() of a full vector)
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::pointer my_segmented_vector<T, Allocator>::address(size_type index) const noexcept {
+        const size_type k = block_of(index);
+        return k < blocks_.size() ? blocks_[k] + (index - block_begin(k)) : nullptr;
+    }
+
+    template <typename T, typename Allocator>
+    void my_segmented_vector<T, Allocator>::add_block() {
+        const size_type k = blocks_.size();
+        if (k >= static_cast<size_type>(std::numeric_limits<size_type>::digits - first_block_bits - 1))
+        {
+            throw std::length_error("my_segmented_vector: too many elements");
+        }
+        blocks_.reserve(k + 1);
+        blocks_.push_back(alloc_traits::allocate(alloc_, block_size(k)));
+        instrumentation::on_allocate(block_begin(k + 1), block_size(k) * sizeof(T));
+    }
+
+    template <typename T, typename Allocator>
+    void my_segmented_vector<T, Allocator>::destroy_from(size_type new_size) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            for_each_run(new_size, size_, [&](pointer first, size_type count) {
+                for (pointer p = first; p != first + count; ++p)
+                {
+                    alloc_traits::destroy(alloc_, p);
+                }
+            });
+        }
+        size_ = std::min(size_, new_size);
+    }
+
+    // Frees the blocks past the first `keep`; they must not hold elements
+    template <typename T, typename Allocator>
+    void my_segmented_vector<T, Allocator>::release_blocks(size_type keep) noexcept {
+        while (blocks_.size() > keep)
+        {
+            alloc_traits::deallocate(alloc_, blocks_.back(), block_size(blocks_.size() - 1));
+            instrumentation::on_deallocate();
+            blocks_.pop_back();
+        }
+    }
+
+    // Calls visit(ptr, count) for the elements [first, last), one call per block
+    template <typename T, typename Allocator>
+    template <typename Visit>
+    void my_segmented_vector<T, Allocator>::for_each_run(size_type first, size_type last, Visit visit) const {
+        while (first < last)
+        {
+            const size_type k = block_of(first);
+            const size_type run_end = std::min(last, block_begin(k + 1));
+            visit(blocks_[k] + (first - block_begin(k)), run_end - first);
+            first = run_end;
+        }
+    }
+
+    // Constructor implementations
+    template <typename T, typename Allocator>
+    my_segmented_vector<T, Allocator>::my_segmented_vector() noexcept(noexcept(Allocator())) :
+        my_segmented_vector(Allocator()) {}
+
+    template <typename T, typename Allocator>
+    my_segmented_vector<T, Allocator>::my_segmented_vector(const Allocator& alloc) noexcept :
+        alloc_(alloc), blocks_(), size_(0) {}
+
+    template <typename T, typename Allocator>
+    my_segmented_vector<T, Allocator>::my_segmented_vector(size_type n, const T& value, const Allocator& alloc) :
+        my_segmented_vector(alloc) {
+        try
+        {
+            resize(n, value);
+        } catch (...)
+        {
+            clear();
+            release_blocks(0);
+            throw;
+        }
+    }
+
+    template <typename T, typename Allocator>
+    template <typename InputIt, typename>
+    my_segmented_vector<T, Allocator>::my_segmented_vector(InputIt first, InputIt last, const Allocator& alloc) :
+        my_segmented_vector(alloc) {
+        try
+        {
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        } catch (...)
+        {
+            clear();
+            release_blocks(0);
+            throw;
+        }
+    }
+
+    template <typename T, typename Allocator>
+    my_segmented_vector<T, Allocator>::my_segmented_vector(std::initializer_list<T> init, const Allocator& alloc) :
+        my_segmented_vector(init.begin(), init.end(), alloc) {}
+
+    template <typename T, typename Allocator>
+    my_segmented_vector<T, Allocator>::my_segmented_vector(const my_segmented_vector& other) :
+        my_segmented_vector(other.begin(), other.end(), alloc_traits::select_on_container_copy_construction(other.alloc_)) {}
+
+    template <typename T, typename Allocator>
+    my_segmented_vector<T, Allocator>::my_segmented_vector(my_segmented_vector&& other) noexcept :
+        alloc_(std::move(other.alloc_)), blocks_(std::move(other.blocks_)), size_(std::exchange(other.size_, 0)) {}
+
+    template <typename T, typename Allocator>
+    my_segmented_vector<T, Allocator>::~my_segmented_vector() {
+        clear();
+        release_blocks(0);
+    }
+
+    template <typename T, typename Allocator>
+    my_segmented_vector<T, Allocator>& my_segmented_vector<T, Allocator>::operator=(const my_segmented_vector& other) {
+        if (this != &other)
+        {
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+            {
+                if (!alloc_traits::is_always_equal::value && alloc_ != other.alloc_)
+                {
+                    // our blocks can only be freed by the allocator we are about to replace
+                    clear();
+                    release_blocks(0);
+                }
+                alloc_ = other.alloc_;
+            }
+            my_segmented_vector copy(other.begin(), other.end(), alloc_);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    template <typename T, typename Allocator>
+    my_segmented_vector<T, Allocator>& my_segmented_vector<T, Allocator>::operator=(my_segmented_vector&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+        if (this != &other)
+        {
+            if (alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value ||
+                alloc_ == other.alloc_)
+            {
+                clear();
+                release_blocks(0);
+                if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+                {
+                    alloc_ = std::move(other.alloc_);
+                }
+                blocks_.swap(other.blocks_);
+                size_ = std::exchange(other.size_, 0);
+            } else {
+                // allocators stay put, so the elements have to move into our own blocks
+                clear();
+                for (T& value : other)
+                {
+                    emplace_back(std::move(value));
+                }
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::allocator_type my_segmented_vector<T, Allocator>::get_allocator() const noexcept {
+        return alloc_;
+    }
+
+    // Element access
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::reference my_segmented_vector<T, Allocator>::operator[](size_type pos) {
+        const size_type k = block_of(pos);
+        return blocks_[k][pos - block_begin(k)];
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::const_reference my_segmented_vector<T, Allocator>::operator[](size_type pos) const {
+        const size_type k = block_of(pos);
+        return blocks_[k][pos - block_begin(k)];
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::reference my_segmented_vector<T, Allocator>::at(size_type pos) {
+        if (pos >= size_)
+        {
+            throw std::out_of_range("my_segmented_vector::at: index out of range");
+        }
+        return (*this)[pos];
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::const_reference my_segmented_vector<T, Allocator>::at(size_type pos) const {
+        if (pos >= size_)
+        {
+            throw std::out_of_range("my_segmented_vector::at: index out of range");
+        }
+        return (*this)[pos];
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::reference my_segmented_vector<T, Allocator>::front() {
+        return (*this)[0];
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::const_reference my_segmented_vector<T, Allocator>::front() const {
+        return (*this)[0];
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::reference my_segmented_vector<T, Allocator>::back() {
+        return (*this)[size_ - 1];
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::const_reference my_segmented_vector<T, Allocator>::back() const {
+        return (*this)[size_ - 1];
+    }
+
+    // Iterators
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::iterator my_segmented_vector<T, Allocator>::begin() noexcept {
+        return iterator(this, 0);
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::const_iterator my_segmented_vector<T, Allocator>::begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::const_iterator my_segmented_vector<T, Allocator>::cbegin() const noexcept {
+        return begin();
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::iterator my_segmented_vector<T, Allocator>::end() noexcept {
+        return iterator(this, size_);
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::const_iterator my_segmented_vector<T, Allocator>::end() const noexcept {
+        return const_iterator(this, size_);
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::const_iterator my_segmented_vector<T, Allocator>::cend() const noexcept {
+        return end();
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::reverse_iterator my_segmented_vector<T, Allocator>::rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::const_reverse_iterator my_segmented_vector<T, Allocator>::rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::reverse_iterator my_segmented_vector<T, Allocator>::rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::const_reverse_iterator my_segmented_vector<T, Allocator>::rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    // Capacity
+    template <typename T, typename Allocator>
+    bool my_segmented_vector<T, Allocator>::is_empty() const noexcept {
+        return size_ == 0;
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::size_type my_segmented_vector<T, Allocator>::size() const noexcept {
+        return size_;
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::size_type my_segmented_vector<T, Allocator>::max_size() const noexcept {
+        return std::min<size_type>(block_begin(std::numeric_limits<size_type>::digits - first_block_bits - 1),
+                                   alloc_traits::max_size(alloc_));
+    }
+
+    template <typename T, typename Allocator>
+    typename my_segmented_vector<T, Allocator>::size_type my_segmented_vector<T, Allocator>::capacity() const noexcept {
+        return block_begin(blocks_.size());
+    }
+
+    template <typename T, typename Allocator>
+    void my_segmented_vector<T, Allocator>::reserve(size_type new_cap) {
+        while (capacity() < new_cap)
+        {
+            add_block();
+        }
+    }
+
+    // Frees the blocks past the one holding the last element; never moves anything
+    template <typename T, typename Allocator>
+    void my_segmented_vector<T, Allocator>::shrink_to_fit() noexcept {
+        release_blocks(size_ == 0 ? 0 : block_of(size_ - 1) + 1);
+    }
+
+    // Modifiers
+    template <typename T, typename Allocator>
+    void my_segmented_vector<T, Allocator>::clear() noexcept {
+        destroy_from(0);
+    }
+
+    template <typename T, typename Allocator>
+    void my_segmented_vector<T, Allocator>::push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    template <typename T, typename Allocator>
+    void my_segmented_vector<T, Allocator>::push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    // A full vector gets a new block; nothing already stored moves
+    template <typename T, typename Allocator>
+    template <typename... Args>
+    typename my_segmented_vector<T, Allocator>::reference my_segmented_vector<T, Allocator>::emplace_back(Args&&... args) {
+        if (size_ == capacity())
+        {
+            add_block();
+        }
+        pointer slot = address(size_);
+        alloc_traits::construct(alloc_, slot, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    template <typename T, typename Allocator>
+    void my_segmented_vector<T, Allocator>::pop_back() {
+        if (size_ > 0)
+        {
+            destroy_from(size_ - 1);
+        }
+    }
+
+    template <typename T, typename Allocator>
+    void my_segmented_vector<T, Allocator>::resize(size_type new_size) {
+        resize(new_size, T());
+    }
+
+    template <typename T, typename Allocator>
+    void my_segmented_vector<T, Allocator>::resize(size_type new_size, const T& value) {
+        if (new_size < size_)
+        {
+            destroy_from(new_size);
+            return;
+        }
+
+        reserve(new_size);
+        const size_type old_size = size_;
+        try
+        {
+            for_each_run(old_size, new_size, [&](pointer first, size_type count) {
+                for (pointer p = first; p != first + count; ++p)
+                {
+                    alloc_traits::construct(alloc_, p, value);
+                    ++size_;
+                }
+            });
+        } catch (...)
+        {
+            destroy_from(old_size);
+            throw;
+        }
+    }
+
+    template <typename T, typename Allocator>
+    void my_segmented_vector<T, Allocator>::swap(my_segmented_vector& other) noexcept {
+        using std::swap;
+        if constexpr (alloc_traits::propagate_on_container_swap::value)
+        {
+            swap(alloc_, other.alloc_);
+        }
+        blocks_.swap(other.blocks_);
+        swap(size_, other.size_);
+    }
+
+    template <typename T, typename Allocator>
+    my_vector<T, Allocator> my_segmented_vector<T, Allocator>::to_my_vector() const {
+        my_vector<T, Allocator> result(alloc_traits::select_on_container_copy_construction(alloc_));
+        result.reserve(size_);
+        for_each_run(0, size_, [&](const_pointer first, size_type count) { result.append(first, first + count); });
+        return result;
+    }
+
+    // Comparison operators. Equal indices live in equal blocks, so both sides are walked block by
+    // block and each pair of runs goes through my_compare.hpp's fast paths.
+    template <typename T, typename Allocator>
+    bool my_segmented_vector<T, Allocator>::operator==(const my_segmented_vector& other) const {
+        if (size_ != other.size_)
+        {
+            return false;
+        }
+        for (size_type k = 0; block_begin(k) < size_; ++k)
+        {
+            const size_type count = std::min(size_, block_begin(k + 1)) - block_begin(k);
+            if (!equal_elements(blocks_[k], other.blocks_[k], count))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename T, typename Allocator>
+    auto my_segmented_vector<T, Allocator>::operator<=>(const my_segmented_vector& other) const {
+        // shorter first, then element by element, the same order as my_vector
+        using ordering = element_ordering_t<T>;
+        if (size_ != other.size_)
+        {
+            return static_cast<ordering>(size_ <=> other.size_);
+        }
+        for (size_type k = 0; block_begin(k) < size_; ++k)
+        {
+            const size_type count = std::min(size_, block_begin(k + 1)) - block_begin(k);
+            ordering order = compare_elements(blocks_[k], other.blocks_[k], count);
+            if (order != 0)
+            {
+                return order;
+            }
+        }
+        return ordering::equivalent;
+    }
+}; // namespace myVector
+
+#endif // MY_SEGMENTED_VECTOR_H
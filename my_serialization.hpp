@@ -0,0 +1,514 @@
+#ifndef MY_SERIALIZATION_H
+#define MY_SERIALIZATION_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <sys/uio.h>
+#include <unistd.h>
+#define MY_SERIALIZATION_HAS_FD 1
+#endif
+
+#include "my_array.hpp"
+#include "my_vector.hpp"
+
+// Binary snapshots of my_vector and my_array.
+//
+//     [ serial_header, 64 bytes ][ payload ]
+//
+// Flat containers of trivially copyable T store their elements verbatim, so writing and reading
+// is one write/read of the whole buffer. my_vector<my_vector<T>> stores count + 1 uint64 offsets
+// followed by all inner elements back to back. The payload starts 64 bytes in, so a buffer that
+// is page- or cache-line-aligned (an mmap'd file) can be viewed in place with view_from_buffer.
+
+namespace myVector
+{
+    class serialization_error : public std::runtime_error
+    {
+      public:
+        using runtime_error::runtime_error;
+    };
+
+    enum class serial_layout : std::uint8_t
+    {
+        flat = 0,
+        nested = 1 // offsets + flat payload
+    };
+
+    struct serial_header
+    {
+        static constexpr std::uint32_t magic_value = 0x4E56594Du; // "MYVN"
+        static constexpr std::uint16_t current_version = 1;
+
+        std::uint32_t magic = magic_value;
+        std::uint16_t version = current_version;
+        std::uint8_t  little_endian = std::endian::native == std::endian::little;
+        serial_layout layout = serial_layout::flat;
+        std::uint64_t element_size = 0;
+        std::uint64_t count = 0;         // elements, or inner vectors for the nested layout
+        std::uint64_t payload_bytes = 0;
+        std::uint64_t checksum = 0;
+        std::uint8_t  reserved[24] = {};
+    };
+    static_assert(sizeof(serial_header) == 64 && std::is_trivially_copyable_v<serial_header>);
+
+    namespace detail
+    {
+        // 64-bit FNV-1a over whole words (bytes for the tail), chained across payload sections
+        inline std::uint64_t checksum(std::span<const std::byte> bytes, std::uint64_t hash = 0xcbf29ce484222325ull) noexcept {
+            constexpr std::uint64_t prime = 0x100000001b3ull;
+            std::size_t i = 0;
+            for (; i + sizeof(std::uint64_t) <= bytes.size(); i += sizeof(std::uint64_t))
+            {
+                std::uint64_t word;
+                std::memcpy(&word, bytes.data() + i, sizeof(word));
+                hash = (hash ^ word) * prime;
+            }
+            for (; i < bytes.size(); ++i)
+            {
+                hash = (hash ^ static_cast<std::uint64_t>(bytes[i])) * prime;
+            }
+            return hash;
+        }
+
+        template <typename T>
+        std::span<const std::byte> bytes_of(const T* data, std::size_t count) noexcept {
+            return {reinterpret_cast<const std::byte*>(data), count * sizeof(T)};
+        }
+
+        template <typename T>
+        std::span<std::byte> writable_bytes_of(T* data, std::size_t count) noexcept {
+            return {reinterpret_cast<std::byte*>(data), count * sizeof(T)};
+        }
+
+        template <typename T>
+        serial_header make_header(serial_layout layout, std::size_t count,
+                                  std::initializer_list<std::span<const std::byte>> sections) {
+            serial_header header;
+            header.layout = layout;
+            header.element_size = sizeof(T);
+            header.count = count;
+            std::uint64_t hash = 0xcbf29ce484222325ull;
+            for (auto section : sections)
+            {
+                header.payload_bytes += section.size();
+                hash = checksum(section, hash);
+            }
+            header.checksum = hash;
+            return header;
+        }
+
+        // Rejects headers this build can't read as a container of T
+        template <typename T>
+        void check_header(const serial_header& header, serial_layout layout) {
+            if (header.magic != serial_header::magic_value)
+            {
+                throw serialization_error("my_vector: not a my_vector snapshot");
+            }
+            if (header.version != serial_header::current_version)
+            {
+                throw serialization_error("my_vector: unsupported snapshot version " + std::to_string(header.version));
+            }
+            if (static_cast<bool>(header.little_endian) != (std::endian::native == std::endian::little))
+            {
+                throw serialization_error("my_vector: snapshot was written with the other byte order");
+            }
+            if (header.layout != layout)
+            {
+                throw serialization_error("my_vector: snapshot has a different layout (flat vs nested)");
+            }
+            if (header.element_size != sizeof(T))
+            {
+                throw serialization_error("my_vector: element size " + std::to_string(header.element_size) +
+                                          " doesn't match sizeof(T) = " + std::to_string(sizeof(T)));
+            }
+            // the counts come from the file, so compare without multiplying them
+            if (layout == serial_layout::flat &&
+                (header.count > std::numeric_limits<std::uint64_t>::max() / sizeof(T) || header.payload_bytes != header.count * sizeof(T)))
+            {
+                throw serialization_error("my_vector: payload size doesn't match the element count");
+            }
+            if (layout == serial_layout::nested && header.count >= header.payload_bytes / sizeof(std::uint64_t))
+            {
+                throw serialization_error("my_vector: payload is too small for the offsets of the nested snapshot");
+            }
+        }
+
+        inline void verify_checksum(const serial_header& header, std::uint64_t actual) {
+            if (header.checksum != actual)
+            {
+                throw serialization_error("my_vector: checksum mismatch, the snapshot is damaged");
+            }
+        }
+
+        inline void write_sections(std::ostream& out, const serial_header& header,
+                                   std::initializer_list<std::span<const std::byte>> sections) {
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (auto section : sections)
+            {
+                out.write(reinterpret_cast<const char*>(section.data()), static_cast<std::streamsize>(section.size()));
+            }
+            if (!out)
+            {
+                throw serialization_error("my_vector: writing the snapshot failed");
+            }
+        }
+
+        inline void read_exact(std::istream& in, std::span<std::byte> into) {
+            in.read(reinterpret_cast<char*>(into.data()), static_cast<std::streamsize>(into.size()));
+            if (static_cast<std::size_t>(in.gcount()) != into.size())
+            {
+                throw serialization_error("my_vector: snapshot is truncated");
+            }
+        }
+
+#if defined(MY_SERIALIZATION_HAS_FD)
+        // One writev for the header and every section, looping only on partial writes
+        inline void write_sections(int fd, const serial_header& header,
+                                   std::initializer_list<std::span<const std::byte>> sections) {
+            iovec parts[4];
+            int count = 0;
+            parts[count++] = {const_cast<serial_header*>(&header), sizeof(header)};
+            for (auto section : sections)
+            {
+                if (!section.empty())
+                {
+                    parts[count++] = {const_cast<std::byte*>(section.data()), section.size()};
+                }
+            }
+
+            iovec* next = parts;
+            while (count > 0)
+            {
+                ssize_t written = ::writev(fd, next, count);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    throw serialization_error("my_vector: writing the snapshot failed: " + std::string(std::strerror(errno)));
+                }
+                auto left = static_cast<std::size_t>(written);
+                while (count > 0 && left >= next->iov_len)
+                {
+                    left -= next->iov_len;
+                    ++next;
+                    --count;
+                }
+                if (count > 0)
+                {
+                    next->iov_base = static_cast<char*>(next->iov_base) + left;
+                    next->iov_len -= left;
+                }
+            }
+        }
+
+        inline void read_exact(int fd, std::span<std::byte> into) {
+            std::size_t done = 0;
+            while (done < into.size())
+            {
+                ssize_t got = ::read(fd, into.data() + done, into.size() - done);
+                if (got < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (got <= 0)
+                {
+                    throw serialization_error("my_vector: snapshot is truncated");
+                }
+                done += static_cast<std::size_t>(got);
+            }
+        }
+#endif
+
+        template <typename Source>
+        serial_header read_header(Source& source) {
+            serial_header header;
+            read_exact(source, writable_bytes_of(&header, 1));
+            return header;
+        }
+
+        template <typename Vector>
+        void check_fits(const Vector& v, std::uint64_t count) {
+            if (count > v.max_size())
+            {
+                throw serialization_error("my_vector: snapshot holds more elements than the vector can");
+            }
+        }
+
+        // flat my_vector: resize a fresh vector without zeroing and read straight into its buffer;
+        // v only takes it over once the checksum matched
+        template <typename Source, typename T, typename Allocator, typename GrowthPolicy>
+        void read_flat(Source& source, my_vector<T, Allocator, GrowthPolicy>& v) {
+            serial_header header = read_header(source);
+            check_header<T>(header, serial_layout::flat);
+            check_fits(v, header.count);
+            my_vector<T, Allocator, GrowthPolicy> tmp(v.get_allocator());
+            tmp.resize_default_init(header.count);
+            read_exact(source, writable_bytes_of(tmp.data(), tmp.size()));
+            verify_checksum(header, checksum(bytes_of(tmp.data(), tmp.size())));
+            v.swap(tmp);
+        }
+
+        template <typename Source, typename T, std::size_t N>
+        void read_flat(Source& source, my_array<T, N>& a) {
+            serial_header header = read_header(source);
+            check_header<T>(header, serial_layout::flat);
+            if (header.count != N)
+            {
+                throw serialization_error("my_array: snapshot holds " + std::to_string(header.count) + " elements, not " +
+                                          std::to_string(N));
+            }
+            my_array<T, N> tmp; // a damaged snapshot leaves the target untouched
+            read_exact(source, writable_bytes_of(tmp.data(), N));
+            verify_checksum(header, checksum(bytes_of(tmp.data(), N)));
+            a = tmp;
+        }
+
+        template <typename Source, typename T, typename InnerAlloc, typename InnerGrowth, typename Allocator, typename GrowthPolicy>
+        void read_nested(Source& source, my_vector<my_vector<T, InnerAlloc, InnerGrowth>, Allocator, GrowthPolicy>& v) {
+            serial_header header = read_header(source);
+            check_header<T>(header, serial_layout::nested);
+
+            // check_header made sure count + 1 offsets fit in payload_bytes
+            check_fits(v, header.count);
+            my_vector<std::uint64_t> offsets;
+            offsets.resize_default_init(header.count + 1);
+            read_exact(source, writable_bytes_of(offsets.data(), offsets.size()));
+
+            // offsets start at 0 and never decrease, so each one is within the last
+            const std::uint64_t value_bytes = header.payload_bytes - offsets.size() * sizeof(std::uint64_t);
+            const std::uint64_t total = offsets.back();
+            if (offsets.front() != 0 || !std::is_sorted(offsets.begin(), offsets.end()) || value_bytes % sizeof(T) != 0 ||
+                value_bytes / sizeof(T) != total)
+            {
+                throw serialization_error("my_vector: nested snapshot has inconsistent offsets");
+            }
+
+            my_vector<T> values;
+            values.resize_default_init(total);
+            read_exact(source, writable_bytes_of(values.data(), values.size()));
+            verify_checksum(header, checksum(bytes_of(values.data(), values.size()),
+                                             checksum(bytes_of(offsets.data(), offsets.size()))));
+
+            // built aside, so a failure leaves v as it was
+            std::remove_reference_t<decltype(v)> result(v.get_allocator());
+            result.reserve(header.count);
+            for (std::size_t i = 0; i < header.count; ++i)
+            {
+                result.emplace_back(values.data() + offsets[i], values.data() + offsets[i + 1]);
+            }
+            v.swap(result);
+        }
+
+        template <typename Sink, typename T, typename InnerAlloc, typename InnerGrowth, typename Allocator, typename GrowthPolicy>
+        void write_nested(Sink& sink, const my_vector<my_vector<T, InnerAlloc, InnerGrowth>, Allocator, GrowthPolicy>& v) {
+            my_vector<std::uint64_t> offsets;
+            offsets.reserve(v.size() + 1);
+            offsets.push_back(0);
+            for (const auto& inner : v)
+            {
+                offsets.push_back(offsets.back() + inner.size());
+            }
+
+            my_vector<T> values;
+            values.reserve(offsets.back());
+            for (const auto& inner : v)
+            {
+                values.append_range(inner);
+            }
+
+            auto offset_bytes = bytes_of(offsets.data(), offsets.size());
+            auto value_bytes = bytes_of(values.data(), values.size());
+            write_sections(sink, make_header<T>(serial_layout::nested, v.size(), {offset_bytes, value_bytes}),
+                           {offset_bytes, value_bytes});
+        }
+    } // namespace detail
+
+    // write_to / read_from for std streams and, on POSIX, file descriptors
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+        requires std::is_trivially_copyable_v<T>
+    void write_to(std::ostream& out, const my_vector<T, Allocator, GrowthPolicy>& v) {
+        auto payload = detail::bytes_of(v.data(), v.size());
+        detail::write_sections(out, detail::make_header<T>(serial_layout::flat, v.size(), {payload}), {payload});
+    }
+
+    template <typename T, std::size_t N>
+        requires std::is_trivially_copyable_v<T>
+    void write_to(std::ostream& out, const my_array<T, N>& a) {
+        auto payload = detail::bytes_of(a.data(), N);
+        detail::write_sections(out, detail::make_header<T>(serial_layout::flat, N, {payload}), {payload});
+    }
+
+    template <typename T, typename InnerAlloc, typename InnerGrowth, typename Allocator, typename GrowthPolicy>
+        requires std::is_trivially_copyable_v<T>
+    void write_to(std::ostream& out, const my_vector<my_vector<T, InnerAlloc, InnerGrowth>, Allocator, GrowthPolicy>& v) {
+        detail::write_nested(out, v);
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+        requires std::is_trivially_copyable_v<T>
+    void read_from(std::istream& in, my_vector<T, Allocator, GrowthPolicy>& v) {
+        detail::read_flat(in, v);
+    }
+
+    template <typename T, std::size_t N>
+        requires std::is_trivially_copyable_v<T>
+    void read_from(std::istream& in, my_array<T, N>& a) {
+        detail::read_flat(in, a);
+    }
+
+    template <typename T, typename InnerAlloc, typename InnerGrowth, typename Allocator, typename GrowthPolicy>
+        requires std::is_trivially_copyable_v<T>
+    void read_from(std::istream& in, my_vector<my_vector<T, InnerAlloc, InnerGrowth>, Allocator, GrowthPolicy>& v) {
+        detail::read_nested(in, v);
+    }
+
+#if defined(MY_SERIALIZATION_HAS_FD)
+    template <typename T, typename Allocator, typename GrowthPolicy>
+        requires std::is_trivially_copyable_v<T>
+    void write_to(int fd, const my_vector<T, Allocator, GrowthPolicy>& v) {
+        auto payload = detail::bytes_of(v.data(), v.size());
+        detail::write_sections(fd, detail::make_header<T>(serial_layout::flat, v.size(), {payload}), {payload});
+    }
+
+    template <typename T, std::size_t N>
+        requires std::is_trivially_copyable_v<T>
+    void write_to(int fd, const my_array<T, N>& a) {
+        auto payload = detail::bytes_of(a.data(), N);
+        detail::write_sections(fd, detail::make_header<T>(serial_layout::flat, N, {payload}), {payload});
+    }
+
+    template <typename T, typename InnerAlloc, typename InnerGrowth, typename Allocator, typename GrowthPolicy>
+        requires std::is_trivially_copyable_v<T>
+    void write_to(int fd, const my_vector<my_vector<T, InnerAlloc, InnerGrowth>, Allocator, GrowthPolicy>& v) {
+        detail::write_nested(fd, v);
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+        requires std::is_trivially_copyable_v<T>
+    void read_from(int fd, my_vector<T, Allocator, GrowthPolicy>& v) {
+        detail::read_flat(fd, v);
+    }
+
+    template <typename T, std::size_t N>
+        requires std::is_trivially_copyable_v<T>
+    void read_from(int fd, my_array<T, N>& a) {
+        detail::read_flat(fd, a);
+    }
+
+    template <typename T, typename InnerAlloc, typename InnerGrowth, typename Allocator, typename GrowthPolicy>
+        requires std::is_trivially_copyable_v<T>
+    void read_from(int fd, my_vector<my_vector<T, InnerAlloc, InnerGrowth>, Allocator, GrowthPolicy>& v) {
+        detail::read_nested(fd, v);
+    }
+#endif
+
+    // Zero-copy access to a snapshot that is already in memory (an mmap'd file, a received message).
+    // The spans point into buffer, which must outlive them and keep the payload suitably aligned.
+
+    namespace detail
+    {
+        template <typename T>
+        const T* payload_as(std::span<const std::byte> payload) {
+            if (reinterpret_cast<std::uintptr_t>(payload.data()) % alignof(T) != 0)
+            {
+                throw serialization_error("my_vector: snapshot payload is not aligned for this element type");
+            }
+            return reinterpret_cast<const T*>(payload.data());
+        }
+
+        template <typename T>
+        std::span<const std::byte> checked_payload(std::span<const std::byte> buffer, serial_layout layout, bool verify,
+                                                   serial_header& header) {
+            if (buffer.size() < sizeof(serial_header))
+            {
+                throw serialization_error("my_vector: snapshot is truncated");
+            }
+            std::memcpy(&header, buffer.data(), sizeof(header));
+            check_header<T>(header, layout);
+            if (buffer.size() - sizeof(serial_header) < header.payload_bytes)
+            {
+                throw serialization_error("my_vector: snapshot is truncated");
+            }
+            auto payload = buffer.subspan(sizeof(serial_header), header.payload_bytes);
+            if (verify)
+            {
+                verify_checksum(header, checksum(payload));
+            }
+            return payload;
+        }
+    } // namespace detail
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    std::span<const T> view_from_buffer(std::span<const std::byte> buffer, bool verify_checksum = true) {
+        serial_header header;
+        auto payload = detail::checked_payload<T>(buffer, serial_layout::flat, verify_checksum, header);
+        return {detail::payload_as<T>(payload), header.count};
+    }
+
+    // The nested layout seen in place: operator[] is the i-th inner vector as a span
+    template <typename T>
+    class nested_view
+    {
+      public:
+        nested_view(std::span<const std::uint64_t> offsets, std::span<const T> values) noexcept :
+            offsets_(offsets), values_(values) {}
+
+        [[nodiscard]] std::size_t size() const noexcept { return offsets_.size() - 1; }
+        [[nodiscard]] std::span<const T> values() const noexcept { return values_; }
+        std::span<const T> operator[](std::size_t i) const {
+            return values_.subspan(offsets_[i], offsets_[i + 1] - offsets_[i]);
+        }
+
+      private:
+        std::span<const std::uint64_t> offsets_;
+        std::span<const T> values_;
+    };
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    nested_view<T> nested_view_from_buffer(std::span<const std::byte> buffer, bool verify_checksum = true) {
+        serial_header header;
+        auto payload = detail::checked_payload<T>(buffer, serial_layout::nested, verify_checksum, header);
+        const std::size_t offset_bytes = (header.count + 1) * sizeof(std::uint64_t);
+        if (payload.size() < offset_bytes)
+        {
+            throw serialization_error("my_vector: nested snapshot has inconsistent offsets");
+        }
+        std::span<const std::uint64_t> offsets(detail::payload_as<std::uint64_t>(payload), header.count + 1);
+        const std::uint64_t total = offsets.back();
+        if (offsets.front() != 0 || (payload.size() - offset_bytes) / sizeof(T) != total ||
+            (payload.size() - offset_bytes) % sizeof(T) != 0)
+        {
+            throw serialization_error("my_vector: nested snapshot has inconsistent offsets");
+        }
+        for (std::size_t i = 0; i + 1 < offsets.size(); ++i)
+        {
+            if (offsets[i] > offsets[i + 1])
+            {
+                throw serialization_error("my_vector: nested snapshot has inconsistent offsets");
+            }
+        }
+        std::span<const T> values(detail::payload_as<T>(payload.subspan(offset_bytes)), total);
+        return {offsets, values};
+    }
+}; // namespace myVector
+
+#endif // MY_SERIALIZATION_H
@@ -0,0 +1,440 @@
+#ifndef MY_SIMD_H
+#define MY_SIMD_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "my_compare.hpp"
+
+#if !defined(__GNUC__)
+#error "my_simd.hpp needs the GCC/Clang vector extensions"
+#endif
+
+// Explicitly vectorized algorithms over contiguous arrays of arithmetic types: anything with
+// data() and size(), i.e. my_vector, my_array, std::vector, std::span. Every kernel is written
+// once with GCC vector types and compiled for 16-byte (SSE2), 32-byte (AVX2) and 64-byte
+// (AVX-512 with DQ and VL) registers; the widest one the CPU has is picked at run time (the
+// same way as in my_compare.hpp) and whatever doesn't fill a register is done one element at
+// a time.
+// sum, dot and inclusive_scan add floating-point values in a different order than
+// std::accumulate, so their results may differ in the last bits.
+
+namespace myVector
+{
+    namespace simd
+    {
+        template <typename T>
+        concept element = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, long double>;
+
+        // contiguous storage of arithmetic elements
+        template <typename C>
+        concept buffer = requires(C& c) {
+            { c.data() } -> std::convertible_to<const void*>;
+            { c.size() } -> std::convertible_to<std::size_t>;
+        } && element<std::remove_cvref_t<decltype(*std::declval<C&>().data())>>;
+
+        template <buffer C>
+        using element_t = std::remove_cvref_t<decltype(*std::declval<C&>().data())>;
+
+        // Widest register the kernels may use, in bytes (16, 32 or 64); lower it to compare widths
+        inline std::atomic<std::size_t> max_register_bytes{64};
+
+        namespace detail
+        {
+            template <typename T, std::size_t Bytes>
+            using vec [[gnu::vector_size(Bytes)]] = T;
+
+            // the same register seen through an element pointer: unaligned, may alias T
+            template <typename T, std::size_t Bytes>
+            using unaligned_vec [[gnu::vector_size(Bytes), gnu::aligned(alignof(T)), gnu::may_alias]] = T;
+
+            template <typename T, std::size_t Bytes>
+            inline constexpr std::size_t lanes = Bytes / sizeof(T);
+
+            // the lane type of a comparison result on Size-byte elements
+            template <std::size_t Size>
+            using signed_lane = std::conditional_t<
+                Size == 1, std::int8_t,
+                std::conditional_t<Size == 2, std::int16_t, std::conditional_t<Size == 4, std::int32_t, std::int64_t>>>;
+
+            // Bytes worth of elements starting at p, as one register. Helpers hand vectors around
+            // by reference only: wider-than-default vectors by value would change the call ABI.
+            template <std::size_t Bytes, typename T>
+            [[gnu::always_inline]] inline const unaligned_vec<T, Bytes>& load(const T* p) noexcept {
+                return *reinterpret_cast<const unaligned_vec<T, Bytes>*>(p);
+            }
+
+            template <std::size_t Bytes, typename T>
+            [[gnu::always_inline]] inline unaligned_vec<T, Bytes>& store(T* p) noexcept {
+                return *reinterpret_cast<unaligned_vec<T, Bytes>*>(p);
+            }
+
+            template <typename V>
+            [[gnu::always_inline]] inline auto horizontal_sum(const V& v) noexcept {
+                auto total = v[0];
+                for (std::size_t j = 1; j < sizeof(V) / sizeof(v[0]); ++j)
+                {
+                    total += v[j];
+                }
+                return total;
+            }
+
+            // ORs the upper half of a register into the lower half until 16 bytes are left, which
+            // keeps wide comparisons in vector registers instead of spilling them lane by lane
+            template <typename W, std::size_t... I>
+            [[gnu::always_inline]] inline std::uint64_t fold(const W& bits, std::index_sequence<I...>) noexcept {
+                if constexpr (sizeof...(I) == 1)
+                {
+                    return bits[0] | bits[1];
+                } else
+                {
+                    using half = vec<std::uint64_t, sizeof(W) / 2>;
+                    const half folded = __builtin_shufflevector(bits, bits, I...) |
+                                        __builtin_shufflevector(bits, bits, (I + sizeof...(I))...);
+                    return fold(folded, std::make_index_sequence<sizeof...(I) / 2>{});
+                }
+            }
+
+            // true if any lane of any of the comparison results is set. The results are combined as
+            // plain words: OR-ing the masks directly gets folded before the kernel is inlined into its
+            // target-specific caller, and GCC then splits a 64-byte compare into scalar ones.
+            template <typename M, typename... Ms>
+            [[gnu::always_inline]] inline bool any(const M& mask, const Ms&... masks) noexcept {
+                using words = vec<std::uint64_t, sizeof(M)>;
+                const words bits = (reinterpret_cast<const words&>(mask) | ... | reinterpret_cast<const words&>(masks));
+                return fold(bits, std::make_index_sequence<sizeof(M) / 16>{}) != 0;
+            }
+
+            // adds lane i - Shift to every lane i >= Shift
+            template <std::size_t Shift, typename V, std::size_t... I>
+            [[gnu::always_inline]] inline void add_shifted(V& x, std::index_sequence<I...>) noexcept {
+                x += __builtin_shufflevector(x, V{}, (I >= Shift ? I - Shift : sizeof...(I))...);
+            }
+
+            // in-register prefix sum in log2(lanes) shift-and-add steps
+            template <std::size_t Shift = 1, typename V>
+            [[gnu::always_inline]] inline void prefix_sum(V& x) noexcept {
+                constexpr std::size_t width = sizeof(V) / sizeof(x[0]);
+                if constexpr (Shift < width)
+                {
+                    add_shifted<Shift>(x, std::make_index_sequence<width>{});
+                    prefix_sum<Shift * 2>(x);
+                }
+            }
+
+            template <std::size_t Bytes, typename T>
+            [[gnu::always_inline]] inline T sum(const T* p, std::size_t n) noexcept {
+                using V = vec<T, Bytes>;
+                constexpr std::size_t w = lanes<T, Bytes>;
+                // four independent accumulators hide the add latency
+                V a0{}, a1{}, a2{}, a3{};
+                std::size_t i = 0;
+                for (const std::size_t end = n / (4 * w) * (4 * w); i < end; i += 4 * w)
+                {
+                    a0 += load<Bytes>(p + i);
+                    a1 += load<Bytes>(p + i + w);
+                    a2 += load<Bytes>(p + i + 2 * w);
+                    a3 += load<Bytes>(p + i + 3 * w);
+                }
+                for (const std::size_t end = n / w * w; i < end; i += w)
+                {
+                    a0 += load<Bytes>(p + i);
+                }
+                T total = horizontal_sum((a0 + a1) + (a2 + a3));
+                for (; i < n; ++i)
+                {
+                    total += p[i];
+                }
+                return total;
+            }
+
+            template <std::size_t Bytes, typename T>
+            [[gnu::always_inline]] inline T dot(const T* a, const T* b, std::size_t n) noexcept {
+                using V = vec<T, Bytes>;
+                constexpr std::size_t w = lanes<T, Bytes>;
+                V a0{}, a1{}, a2{}, a3{};
+                std::size_t i = 0;
+                for (const std::size_t end = n / (4 * w) * (4 * w); i < end; i += 4 * w)
+                {
+                    a0 += load<Bytes>(a + i) * load<Bytes>(b + i);
+                    a1 += load<Bytes>(a + i + w) * load<Bytes>(b + i + w);
+                    a2 += load<Bytes>(a + i + 2 * w) * load<Bytes>(b + i + 2 * w);
+                    a3 += load<Bytes>(a + i + 3 * w) * load<Bytes>(b + i + 3 * w);
+                }
+                for (const std::size_t end = n / w * w; i < end; i += w)
+                {
+                    a0 += load<Bytes>(a + i) * load<Bytes>(b + i);
+                }
+                T total = horizontal_sum((a0 + a1) + (a2 + a3));
+                for (; i < n; ++i)
+                {
+                    total += a[i] * b[i];
+                }
+                return total;
+            }
+
+            // n > 0
+            template <std::size_t Bytes, typename T>
+            [[gnu::always_inline]] inline std::pair<T, T> minmax(const T* p, std::size_t n) noexcept {
+                using V = vec<T, Bytes>;
+                constexpr std::size_t w = lanes<T, Bytes>;
+                T lo = p[0], hi = p[0];
+                std::size_t i = 0;
+                if (n >= w)
+                {
+                    V vlo = load<Bytes>(p), vhi = vlo;
+                    for (const std::size_t end = n / w * w; i < end; i += w)
+                    {
+                        const V x = load<Bytes>(p + i);
+                        vlo = x < vlo ? x : vlo;
+                        vhi = x > vhi ? x : vhi;
+                    }
+                    for (std::size_t j = 0; j < w; ++j)
+                    {
+                        lo = vlo[j] < lo ? vlo[j] : lo;
+                        hi = vhi[j] > hi ? vhi[j] : hi;
+                    }
+                }
+                for (; i < n; ++i)
+                {
+                    lo = p[i] < lo ? p[i] : lo;
+                    hi = p[i] > hi ? p[i] : hi;
+                }
+                return {lo, hi};
+            }
+
+            template <std::size_t Bytes, typename T>
+            [[gnu::always_inline]] inline std::size_t find(const T* p, std::size_t n, T value) noexcept {
+                using V = vec<T, Bytes>;
+                constexpr std::size_t w = lanes<T, Bytes>;
+                const V needle = V{} + value;
+                std::size_t i = 0;
+                // skip whole registers without a match, then pin the lane down one element at a time
+                for (const std::size_t end = n / (4 * w) * (4 * w); i < end; i += 4 * w)
+                {
+                    if (any(load<Bytes>(p + i) == needle, load<Bytes>(p + i + w) == needle,
+                            load<Bytes>(p + i + 2 * w) == needle, load<Bytes>(p + i + 3 * w) == needle))
+                    {
+                        break;
+                    }
+                }
+                for (const std::size_t end = n / w * w; i < end; i += w)
+                {
+                    if (any(load<Bytes>(p + i) == needle))
+                    {
+                        break;
+                    }
+                }
+                for (; i < n; ++i)
+                {
+                    if (p[i] == value)
+                    {
+                        return i;
+                    }
+                }
+                return n;
+            }
+
+            template <std::size_t Bytes, typename T>
+            [[gnu::always_inline]] inline std::size_t count(const T* p, std::size_t n, T value) noexcept {
+                using V = vec<T, Bytes>;
+                using M = decltype(V{} == V{}); // lanes are 0 or -1, as wide as T
+                using counter = signed_lane<sizeof(T)>;
+                constexpr std::size_t w = lanes<T, Bytes>;
+                const V needle = V{} + value;
+                const std::size_t end = n / w * w;
+                std::size_t total = 0;
+                std::size_t i = 0;
+                while (i < end)
+                {
+                    // subtracting the masks counts per lane, flushed before a narrow counter overflows
+                    const std::size_t stop =
+                        i + std::min<std::size_t>((end - i) / w, static_cast<std::size_t>(std::numeric_limits<counter>::max())) * w;
+                    M hits{};
+                    for (; i < stop; i += w)
+                    {
+                        hits -= load<Bytes>(p + i) == needle;
+                    }
+                    for (std::size_t j = 0; j < w; ++j)
+                    {
+                        total += static_cast<std::size_t>(hits[j]);
+                    }
+                }
+                for (; i < n; ++i)
+                {
+                    total += p[i] == value;
+                }
+                return total;
+            }
+
+            // op runs on one register's worth of elements at a time, in a fixed-length loop the
+            // compiler turns into vector instructions of the dispatched width
+            template <std::size_t Bytes, typename T, typename Op>
+            [[gnu::always_inline]] inline void transform(const T* in, T* out, std::size_t n, Op& op) {
+                constexpr std::size_t w = lanes<T, Bytes>;
+                std::size_t i = 0;
+                for (const std::size_t end = n / w * w; i < end; i += w)
+                {
+                    T block[w];
+                    std::memcpy(block, in + i, sizeof(block));
+#pragma GCC unroll 64
+                    for (std::size_t j = 0; j < w; ++j)
+                    {
+                        block[j] = static_cast<T>(op(block[j]));
+                    }
+                    std::memcpy(out + i, block, sizeof(block));
+                }
+                for (; i < n; ++i)
+                {
+                    out[i] = static_cast<T>(op(in[i]));
+                }
+            }
+
+            template <std::size_t Bytes, typename T>
+            [[gnu::always_inline]] inline void inclusive_scan(const T* in, T* out, std::size_t n) noexcept {
+                using V = vec<T, Bytes>;
+                constexpr std::size_t w = lanes<T, Bytes>;
+                V carry{};
+                std::size_t i = 0;
+                for (const std::size_t end = n / w * w; i < end; i += w)
+                {
+                    V x = load<Bytes>(in + i);
+                    prefix_sum(x);
+                    x += carry;
+                    store<Bytes>(out + i) = x;
+                    carry = V{} + x[w - 1];
+                }
+                T running = carry[0];
+                for (; i < n; ++i)
+                {
+                    running += in[i];
+                    out[i] = running;
+                }
+            }
+
+            template <std::size_t Bytes>
+            using width = std::integral_constant<std::size_t, Bytes>;
+
+#if defined(MY_COMPARE_X86)
+            inline bool has_avx512() noexcept {
+                static const bool supported = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                                             __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl");
+                return supported;
+            }
+
+            template <typename Kernel>
+            __attribute__((target("avx2"))) decltype(auto) run_avx2(Kernel& kernel) {
+                return kernel(width<32>{});
+            }
+
+            template <typename Kernel>
+            __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) decltype(auto) run_avx512(Kernel& kernel) {
+                return kernel(width<64>{});
+            }
+#endif
+
+            // Calls kernel(width<Bytes>{}) compiled for the widest register available. The kernel
+            // must be always_inline so that it is generated inside the target-specific caller, and
+            // for a lambda that takes __attribute__: [[gnu::always_inline]] in that spot is ignored.
+            template <typename Kernel>
+            decltype(auto) dispatch(Kernel&& kernel) {
+#if defined(MY_COMPARE_X86)
+                const std::size_t limit = max_register_bytes.load(std::memory_order_relaxed);
+                if (limit >= 64 && has_avx512())
+                {
+                    return run_avx512(kernel);
+                }
+                if (limit >= 32 && myVector::detail::has_avx2())
+                {
+                    return run_avx2(kernel);
+                }
+#endif
+                return kernel(width<16>{});
+            }
+        } // namespace detail
+
+        template <buffer C>
+        element_t<C> sum(const C& c) {
+            const auto* p = c.data();
+            const std::size_t n = c.size();
+            return detail::dispatch([p, n](auto w) __attribute__((always_inline)) { return detail::sum<decltype(w)::value>(p, n); });
+        }
+
+        // {smallest, largest}; unspecified if the range holds a NaN
+        template <buffer C>
+        std::pair<element_t<C>, element_t<C>> minmax(const C& c) {
+            const auto* p = c.data();
+            const std::size_t n = c.size();
+            if (n == 0)
+            {
+                throw std::length_error("myVector::simd::minmax: empty range");
+            }
+            return detail::dispatch([p, n](auto w) __attribute__((always_inline)) { return detail::minmax<decltype(w)::value>(p, n); });
+        }
+
+        template <buffer A, buffer B>
+            requires std::is_same_v<element_t<A>, element_t<B>>
+        element_t<A> dot(const A& a, const B& b) {
+            if (a.size() != b.size())
+            {
+                throw std::length_error("myVector::simd::dot: size mismatch");
+            }
+            const auto* pa = a.data();
+            const auto* pb = b.data();
+            const std::size_t n = a.size();
+            return detail::dispatch([pa, pb, n](auto w) __attribute__((always_inline)) { return detail::dot<decltype(w)::value>(pa, pb, n); });
+        }
+
+        // Index of the first element == value, or size()
+        template <buffer C>
+        std::size_t find(const C& c, element_t<C> value) {
+            const auto* p = c.data();
+            const std::size_t n = c.size();
+            return detail::dispatch([p, n, value](auto w) __attribute__((always_inline)) { return detail::find<decltype(w)::value>(p, n, value); });
+        }
+
+        template <buffer C>
+        std::size_t count(const C& c, element_t<C> value) {
+            const auto* p = c.data();
+            const std::size_t n = c.size();
+            return detail::dispatch([p, n, value](auto w) __attribute__((always_inline)) { return detail::count<decltype(w)::value>(p, n, value); });
+        }
+
+        // out[i] = op(in[i]); out may be in itself, otherwise the two must not overlap
+        template <buffer In, buffer Out, typename Op>
+            requires std::is_same_v<element_t<In>, element_t<Out>> && std::is_invocable_v<Op&, element_t<In>>
+        void transform(const In& in, Out& out, Op op) {
+            if (out.size() < in.size())
+            {
+                throw std::length_error("myVector::simd::transform: output too small");
+            }
+            const auto* src = in.data();
+            auto* dst = out.data();
+            const std::size_t n = in.size();
+            detail::dispatch([src, dst, n, &op](auto w) __attribute__((always_inline)) { detail::transform<decltype(w)::value>(src, dst, n, op); });
+        }
+
+        // out[i] = in[0] + ... + in[i]; same aliasing rules as transform
+        template <buffer In, buffer Out>
+            requires std::is_same_v<element_t<In>, element_t<Out>>
+        void inclusive_scan(const In& in, Out& out) {
+            if (out.size() < in.size())
+            {
+                throw std::length_error("myVector::simd::inclusive_scan: output too small");
+            }
+            const auto* src = in.data();
+            auto* dst = out.data();
+            const std::size_t n = in.size();
+            detail::dispatch([src, dst, n](auto w) __attribute__((always_inline)) { detail::inclusive_scan<decltype(w)::value>(src, dst, n); });
+        }
+    } // namespace simd
+}; // namespace myVector
+
+#endif // MY_SIMD_H
@@ -0,0 +1,900 @@
+#ifndef MY_SMALL_VECTOR_H
+#define MY_SMALL_VECTOR_H
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "my_array.hpp"
+#include "my_vector.hpp"
+
+namespace myVector
+{
+    // my_vector with the first N elements stored inside the object.
+    // Nothing touches the heap until the size outgrows N, after that it behaves like my_vector.
+    // Iterators are my_vector's, so code written against my_vector<T>::iterator works unchanged.
+    template <typename T, std::size_t N, typename Allocator = std::allocator<T>>
+    class my_small_vector
+    {
+        static_assert(N > 0, "my_small_vector: use my_vector for N == 0");
+
+        using alloc_traits = std::allocator_traits<Allocator>;
+        using heap_vector = my_vector<T, Allocator>;
+
+      public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+
+        using iterator = typename heap_vector::iterator;
+        using const_iterator = typename heap_vector::const_iterator;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        static constexpr size_type inline_capacity = N;
+
+      private:
+        [[no_unique_address]] allocator_type alloc_;    // where spilled buffers come from
+        pointer                              data_;     // inline_ or a heap buffer
+        size_type                            size_;     // number of elements
+        size_type                            capacity_; // N while inline
+        // raw storage laid out like my_array<T, N>, elements are constructed on demand
+        alignas(my_array<T, N>) std::byte inline_[sizeof(my_array<T, N>)];
+
+        // Helper method declarations
+        pointer       inline_data() noexcept;
+        const_pointer inline_data() const noexcept;
+        pointer       allocate(size_type n);
+        void          deallocate() noexcept;
+        template <typename... Args>
+        void construct(pointer ptr, Args&&... args);
+        void destroy(pointer ptr) noexcept;
+        void destroy_range(pointer first, pointer last) noexcept;
+        void relocate_range(pointer first, pointer last, pointer dest);
+        void finish_relocation(pointer first, pointer last) noexcept;
+        void take_contents(my_small_vector& other);
+        void reallocate(size_type new_capacity);
+        template <typename Fill>
+        void reallocate_insert(size_type index, size_type count, size_type new_capacity, Fill&& fill);
+        template <typename Fill>
+        void emplace_gap(size_type index, size_type count, Fill&& fill);
+        [[nodiscard]] size_type calculate_growth(size_type new_size) const;
+
+      public:
+        // Constructor declarations
+        my_small_vector() noexcept(noexcept(Allocator()));
+        explicit my_small_vector(const Allocator& alloc) noexcept;
+        explicit my_small_vector(size_type n, const T& value = T(), const Allocator& alloc = Allocator());
+        template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        my_small_vector(InputIt first, InputIt last, const Allocator& alloc = Allocator());
+        my_small_vector(std::initializer_list<T> init, const Allocator& alloc = Allocator());
+        my_small_vector(const my_small_vector& other);
+        my_small_vector(my_small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+        // Destructor declaration
+        ~my_small_vector();
+
+        // Operator declarations
+        my_small_vector& operator=(const my_small_vector& other);
+        my_small_vector& operator=(my_small_vector&& other);
+        my_small_vector& operator=(std::initializer_list<T> ilist);
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept;
+
+        // Element access
+        reference       operator[](size_type pos);
+        const_reference operator[](size_type pos) const;
+        reference       at(size_type pos);
+        const_reference at(size_type pos) const;
+        reference       front();
+        const_reference front() const;
+        reference       back();
+        const_reference back() const;
+        pointer         data() noexcept;
+        const_pointer   data() const noexcept;
+
+        // Capacity
+        [[nodiscard]] bool      is_empty() const noexcept;
+        [[nodiscard]] bool      is_inline() const noexcept;
+        [[nodiscard]] size_type size() const noexcept;
+        [[nodiscard]] size_type max_size() const noexcept;
+        void                    reserve(size_type new_cap);
+        [[nodiscard]] size_type capacity() const noexcept;
+        void                    shrink_to_fit();
+
+        // Modifiers
+        void clear() noexcept;
+        void push_back(const T& value);
+        void push_back(T&& value);
+        template <typename... Args>
+        reference emplace_back(Args&&... args);
+        void      pop_back();
+        void      resize(size_type new_size);
+        void      resize(size_type new_size, const T& value);
+        void      assign(size_type n, const T& value);
+        template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        void assign(InputIt first, InputIt last);
+        void assign(std::initializer_list<T> ilist);
+        void swap(my_small_vector& other);
+
+        // Comparison operators
+        bool operator==(const my_small_vector& other) const;
+        auto operator<=>(const my_small_vector& other) const;
+
+        // Iterators
+        iterator               begin() noexcept;
+        const_iterator         begin() const noexcept;
+        const_iterator         cbegin() const noexcept;
+        iterator               end() noexcept;
+        const_iterator         end() const noexcept;
+        const_iterator         cend() const noexcept;
+        reverse_iterator       rbegin() noexcept;
+        const_reverse_iterator rbegin() const noexcept;
+        const_reverse_iterator crbegin() const noexcept;
+        reverse_iterator       rend() noexcept;
+        const_reverse_iterator rend() const noexcept;
+        const_reverse_iterator crend() const noexcept;
+
+        // Modifiers
+        iterator insert(const_iterator pos, const T& value);
+        iterator insert(const_iterator pos, T&& value);
+        iterator insert(const_iterator pos, size_type n, const T& value);
+        template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        iterator insert(const_iterator pos, InputIt first, InputIt last);
+        iterator insert(const_iterator pos, std::initializer_list<T> ilist);
+        iterator erase(const_iterator pos);
+        iterator erase(const_iterator first, const_iterator last);
+    };
+
+    // Constructor implementations
+    template <typename T, std::size_t N, typename Allocator>
+    my_small_vector<T, N, Allocator>::my_small_vector() noexcept(noexcept(Allocator())) : my_small_vector(Allocator()) {}
+
+    template <typename T, std::size_t N, typename Allocator>
+    my_small_vector<T, N, Allocator>::my_small_vector(const Allocator& alloc) noexcept :
+        alloc_(alloc), data_(inline_data()), size_(0), capacity_(N) {}
+
+    template <typename T, std::size_t N, typename Allocator>
+    my_small_vector<T, N, Allocator>::my_small_vector(size_type n, const T& value, const Allocator& alloc) :
+        my_small_vector(alloc) {
+        assign(n, value);
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    template <typename InputIt, typename>
+    my_small_vector<T, N, Allocator>::my_small_vector(InputIt first, InputIt last, const Allocator& alloc) :
+        my_small_vector(alloc) {
+        assign(first, last);
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    my_small_vector<T, N, Allocator>::my_small_vector(std::initializer_list<T> init, const Allocator& alloc) :
+        my_small_vector(alloc) {
+        assign(init.begin(), init.end());
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    my_small_vector<T, N, Allocator>::my_small_vector(const my_small_vector& other) :
+        my_small_vector(alloc_traits::select_on_container_copy_construction(other.alloc_)) {
+        assign(other.begin(), other.end());
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    my_small_vector<T, N, Allocator>::my_small_vector(my_small_vector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) : my_small_vector(std::move(other.alloc_)) {
+        take_contents(other);
+    }
+
+    // Destructor implementation
+    template <typename T, std::size_t N, typename Allocator>
+    my_small_vector<T, N, Allocator>::~my_small_vector() {
+        clear();
+        deallocate();
+    }
+
+    // Assignment operators implementation
+    // Copy
+    template <typename T, std::size_t N, typename Allocator>
+    my_small_vector<T, N, Allocator>& my_small_vector<T, N, Allocator>::operator=(const my_small_vector& other) {
+        if (this != &other)
+        {
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+            {
+                if (!alloc_traits::is_always_equal::value && alloc_ != other.alloc_)
+                {
+                    clear();
+                    deallocate();
+                }
+                alloc_ = other.alloc_;
+            }
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    // Move
+    template <typename T, std::size_t N, typename Allocator>
+    my_small_vector<T, N, Allocator>& my_small_vector<T, N, Allocator>::operator=(my_small_vector&& other) {
+        if (this != &other)
+        {
+            clear();
+            deallocate();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+            {
+                alloc_ = std::move(other.alloc_);
+            }
+            take_contents(other);
+        }
+        return *this;
+    }
+
+    // Init list
+    template <typename T, std::size_t N, typename Allocator>
+    my_small_vector<T, N, Allocator>& my_small_vector<T, N, Allocator>::operator=(std::initializer_list<T> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::allocator_type my_small_vector<T, N, Allocator>::get_allocator() const noexcept {
+        return alloc_;
+    }
+
+    // Element access implementations
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::reference my_small_vector<T, N, Allocator>::operator[](size_type pos) {
+        return data_[pos];
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::const_reference my_small_vector<T, N, Allocator>::operator[](
+        size_type pos) const {
+        return data_[pos];
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::reference my_small_vector<T, N, Allocator>::at(size_type pos) {
+        if (pos >= size_)
+        {
+            throw std::out_of_range("my_small_vector::at: index out of range");
+        }
+        return data_[pos];
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::const_reference my_small_vector<T, N, Allocator>::at(size_type pos) const {
+        if (pos >= size_)
+        {
+            throw std::out_of_range("my_small_vector::at: index out of range");
+        }
+        return data_[pos];
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::reference my_small_vector<T, N, Allocator>::front() {
+        return data_[0];
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::const_reference my_small_vector<T, N, Allocator>::front() const {
+        return data_[0];
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::reference my_small_vector<T, N, Allocator>::back() {
+        return data_[size_ - 1];
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::const_reference my_small_vector<T, N, Allocator>::back() const {
+        return data_[size_ - 1];
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::pointer my_small_vector<T, N, Allocator>::data() noexcept {
+        return data_;
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::const_pointer my_small_vector<T, N, Allocator>::data() const noexcept {
+        return data_;
+    }
+
+    // Iterator implementations
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::iterator my_small_vector<T, N, Allocator>::begin() noexcept {
+        return iterator(data_);
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::const_iterator my_small_vector<T, N, Allocator>::begin() const noexcept {
+        return const_iterator(data_);
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::const_iterator my_small_vector<T, N, Allocator>::cbegin() const noexcept {
+        return const_iterator(data_);
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::iterator my_small_vector<T, N, Allocator>::end() noexcept {
+        return iterator(data_ + size_);
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::const_iterator my_small_vector<T, N, Allocator>::end() const noexcept {
+        return const_iterator(data_ + size_);
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::const_iterator my_small_vector<T, N, Allocator>::cend() const noexcept {
+        return const_iterator(data_ + size_);
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::reverse_iterator my_small_vector<T, N, Allocator>::rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::const_reverse_iterator my_small_vector<T, N, Allocator>::rbegin()
+        const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::const_reverse_iterator my_small_vector<T, N, Allocator>::crbegin()
+        const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::reverse_iterator my_small_vector<T, N, Allocator>::rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::const_reverse_iterator my_small_vector<T, N, Allocator>::rend()
+        const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::const_reverse_iterator my_small_vector<T, N, Allocator>::crend()
+        const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    // Capacity implementations
+    template <typename T, std::size_t N, typename Allocator>
+    bool my_small_vector<T, N, Allocator>::is_empty() const noexcept {
+        return size_ == 0;
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    bool my_small_vector<T, N, Allocator>::is_inline() const noexcept {
+        return data_ == inline_data();
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::size_type my_small_vector<T, N, Allocator>::size() const noexcept {
+        return size_;
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::size_type my_small_vector<T, N, Allocator>::max_size() const noexcept {
+        return std::min<size_type>(alloc_traits::max_size(alloc_), std::numeric_limits<size_type>::max() / sizeof(T));
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::reserve(size_type new_cap) {
+        if (new_cap > capacity_)
+        {
+            reallocate(new_cap);
+        }
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::size_type my_small_vector<T, N, Allocator>::capacity() const noexcept {
+        return capacity_;
+    }
+
+    // Moves back into the inline buffer when the elements fit there
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::shrink_to_fit() {
+        if (!is_inline() && size_ < capacity_)
+        {
+            reallocate(size_);
+        }
+    }
+
+    // Modifier implementations
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::clear() noexcept {
+        destroy_range(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    template <typename... Args>
+    typename my_small_vector<T, N, Allocator>::reference my_small_vector<T, N, Allocator>::emplace_back(Args&&... args) {
+        if (size_ == capacity_)
+        {
+            size_type new_capacity = calculate_growth(size_ + 1);
+            reallocate_insert(size_, 1, new_capacity, [&](pointer gap) { construct(gap, std::forward<Args>(args)...); });
+        } else {
+            construct(data_ + size_, std::forward<Args>(args)...);
+            ++size_;
+        }
+
+        return back();
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::pop_back() {
+        if (size_ > 0)
+        {
+            --size_;
+            destroy(data_ + size_);
+        }
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::resize(size_type new_size) {
+        resize(new_size, T());
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::resize(size_type new_size, const T& value) {
+        if (new_size > size_)
+        {
+            insert(cend(), new_size - size_, value);
+        } else if (new_size < size_) {
+            destroy_range(data_ + new_size, data_ + size_);
+            size_ = new_size;
+        }
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::assign(size_type n, const T& value) {
+        T value_copy(value);
+        clear();
+        insert(cend(), n, value_copy);
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    template <typename InputIt, typename>
+    void my_small_vector<T, N, Allocator>::assign(InputIt first, InputIt last) {
+        clear();
+        insert(cend(), first, last);
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::assign(std::initializer_list<T> ilist) {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    // Two heap buffers trade pointers, anything inline has to move element by element
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::swap(my_small_vector& other) {
+        if (!is_inline() && !other.is_inline())
+        {
+            using std::swap;
+            if constexpr (alloc_traits::propagate_on_container_swap::value)
+            {
+                swap(alloc_, other.alloc_);
+            }
+            swap(data_, other.data_);
+            swap(size_, other.size_);
+            swap(capacity_, other.capacity_);
+        } else {
+            my_small_vector tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::iterator my_small_vector<T, N, Allocator>::insert(const_iterator pos,
+                                                                                                  const T&       value) {
+        size_type index = pos - cbegin();
+        if (size_ == capacity_)
+        {
+            reallocate_insert(index, 1, calculate_growth(size_ + 1), [&](pointer gap) { construct(gap, value); });
+        } else {
+            // value may live in the part that is about to shift
+            T value_copy(value);
+            emplace_gap(index, 1, [&](pointer gap) { construct(gap, std::move(value_copy)); });
+        }
+        return begin() + index;
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::iterator my_small_vector<T, N, Allocator>::insert(const_iterator pos,
+                                                                                                  T&&            value) {
+        size_type index = pos - cbegin();
+        emplace_gap(index, 1, [&](pointer gap) { construct(gap, std::move(value)); });
+        return begin() + index;
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::iterator my_small_vector<T, N, Allocator>::insert(
+        const_iterator pos, size_type n, const T& value) {
+        size_type index = pos - cbegin();
+        if (n == 0)
+        {
+            return begin() + index;
+        }
+
+        T value_copy(value);
+        emplace_gap(index, n, [&](pointer gap) {
+            size_type constructed = 0;
+            try
+            {
+                for (; constructed < n; ++constructed)
+                {
+                    construct(gap + constructed, value_copy);
+                }
+            } catch (...)
+            {
+                destroy_range(gap, gap + constructed);
+                throw;
+            }
+        });
+        return begin() + index;
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    template <typename InputIt, typename>
+    typename my_small_vector<T, N, Allocator>::iterator my_small_vector<T, N, Allocator>::insert(
+        const_iterator pos, InputIt first, InputIt last) {
+        size_type index = pos - cbegin();
+
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                        typename std::iterator_traits<InputIt>::iterator_category>)
+        {
+            size_type count = std::distance(first, last);
+            if (count > 0)
+            {
+                emplace_gap(index, count, [&](pointer gap) {
+                    size_type constructed = 0;
+                    try
+                    {
+                        for (; constructed < count; ++constructed, ++first)
+                        {
+                            construct(gap + constructed, *first);
+                        }
+                    } catch (...)
+                    {
+                        destroy_range(gap, gap + constructed);
+                        throw;
+                    }
+                });
+            }
+        } else {
+            // single pass: append, then rotate the new tail into place
+            size_type old_size = size_;
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+            std::rotate(begin() + index, begin() + old_size, end());
+        }
+        return begin() + index;
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::iterator my_small_vector<T, N, Allocator>::insert(
+        const_iterator pos, std::initializer_list<T> ilist) {
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::iterator my_small_vector<T, N, Allocator>::erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::iterator my_small_vector<T, N, Allocator>::erase(const_iterator first,
+                                                                                                 const_iterator last) {
+        size_type index_first = first - cbegin();
+        size_type index_last = last - cbegin();
+        size_type count = index_last - index_first;
+
+        if (count > 0)
+        {
+            if constexpr (is_trivially_relocatable_v<T>)
+            {
+                destroy_range(data_ + index_first, data_ + index_last);
+                std::memmove(static_cast<void*>(data_ + index_first), static_cast<const void*>(data_ + index_last),
+                             (size_ - index_last) * sizeof(T));
+            } else {
+                std::move(data_ + index_last, data_ + size_, data_ + index_first);
+                destroy_range(data_ + size_ - count, data_ + size_);
+            }
+            size_ -= count;
+        }
+        return begin() + index_first;
+    }
+
+    // comparison operators, same ordering as my_vector: shorter sorts first
+    template <typename T, std::size_t N, typename Allocator>
+    bool my_small_vector<T, N, Allocator>::operator==(const my_small_vector& other) const {
+        return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    auto my_small_vector<T, N, Allocator>::operator<=>(const my_small_vector& other) const {
+        using ordering = std::common_comparison_category_t<std::compare_three_way_result_t<T>, std::strong_ordering>;
+        if (size_ != other.size_)
+        {
+            return ordering(size_ <=> other.size_);
+        }
+
+        for (size_type i = 0; i < size_; ++i)
+        {
+            if (auto cmp = data_[i] <=> other.data_[i]; cmp != 0)
+            {
+                return ordering(cmp);
+            }
+        }
+
+        return ordering(std::strong_ordering::equal);
+    }
+
+    // Helper method implementations
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::pointer my_small_vector<T, N, Allocator>::inline_data() noexcept {
+        return reinterpret_cast<pointer>(inline_);
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::const_pointer my_small_vector<T, N, Allocator>::inline_data()
+        const noexcept {
+        return reinterpret_cast<const_pointer>(inline_);
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::pointer my_small_vector<T, N, Allocator>::allocate(size_type n) {
+        return alloc_traits::allocate(alloc_, n);
+    }
+
+    // Frees a heap buffer (elements must be destroyed already) and falls back to inline storage
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::deallocate() noexcept {
+        if (!is_inline())
+        {
+            alloc_traits::deallocate(alloc_, data_, capacity_);
+            data_ = inline_data();
+            capacity_ = N;
+        }
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    template <typename... Args>
+    void my_small_vector<T, N, Allocator>::construct(pointer ptr, Args&&... args) {
+        alloc_traits::construct(alloc_, ptr, std::forward<Args>(args)...);
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::destroy(pointer ptr) noexcept {
+        alloc_traits::destroy(alloc_, ptr);
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::destroy_range(pointer first, pointer last) noexcept {
+        for (pointer ptr = first; ptr != last; ++ptr)
+        {
+            destroy(ptr);
+        }
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::relocate_range(pointer first, pointer last, pointer dest) {
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            if (first != last)
+            {
+                std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(T));
+            }
+        } else {
+            pointer current = dest;
+            try
+            {
+                for (; first != last; ++first, ++current)
+                {
+                    construct(current, std::move(*first));
+                }
+            } catch (...)
+            {
+                destroy_range(dest, current);
+                throw;
+            }
+        }
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::finish_relocation(pointer first, pointer last) noexcept {
+        if constexpr (!is_trivially_relocatable_v<T>)
+        {
+            destroy_range(first, last);
+        }
+    }
+
+    // *this must be empty and inline. A heap buffer is taken over when our allocator can free it,
+    // inline elements (or a buffer owned by a foreign allocator) are moved over one by one.
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::take_contents(my_small_vector& other) {
+        if (!other.is_inline() && (alloc_traits::is_always_equal::value || alloc_ == other.alloc_))
+        {
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+
+            other.data_ = other.inline_data();
+            other.size_ = 0;
+            other.capacity_ = N;
+        } else if (other.is_inline()) {
+            relocate_range(other.data_, other.data_ + other.size_, data_);
+            other.finish_relocation(other.data_, other.data_ + other.size_);
+            size_ = other.size_;
+            other.size_ = 0;
+        } else {
+            insert(cend(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+            other.clear();
+        }
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    void my_small_vector<T, N, Allocator>::reallocate(size_type new_capacity) {
+        reallocate_insert(size_, 0, new_capacity, [](pointer) {});
+    }
+
+    // Same contract as my_vector::reallocate_insert. Capacities up to N land in the inline buffer.
+    template <typename T, std::size_t N, typename Allocator>
+    template <typename Fill>
+    void my_small_vector<T, N, Allocator>::reallocate_insert(size_type index, size_type count, size_type new_capacity,
+                                                             Fill&& fill) {
+        const bool to_inline = new_capacity <= N;
+        if (to_inline)
+        {
+            new_capacity = N;
+        }
+        pointer new_data = to_inline ? inline_data() : allocate(new_capacity);
+
+        try
+        {
+            fill(new_data + index);
+        } catch (...)
+        {
+            if (!to_inline)
+            {
+                alloc_traits::deallocate(alloc_, new_data, new_capacity);
+            }
+            throw;
+        }
+
+        try
+        {
+            relocate_range(data_, data_ + index, new_data);
+            try
+            {
+                relocate_range(data_ + index, data_ + size_, new_data + index + count);
+            } catch (...)
+            {
+                destroy_range(new_data, new_data + index);
+                throw;
+            }
+        } catch (...)
+        {
+            destroy_range(new_data + index, new_data + index + count);
+            if (!to_inline)
+            {
+                alloc_traits::deallocate(alloc_, new_data, new_capacity);
+            }
+            throw;
+        }
+
+        finish_relocation(data_, data_ + size_);
+        deallocate();
+
+        data_ = new_data;
+        size_ += count;
+        capacity_ = new_capacity;
+    }
+
+    // Opens a hole of `count` slots at `index` and lets `fill` construct them, growing if needed
+    template <typename T, std::size_t N, typename Allocator>
+    template <typename Fill>
+    void my_small_vector<T, N, Allocator>::emplace_gap(size_type index, size_type count, Fill&& fill) {
+        if (size_ + count > capacity_)
+        {
+            reallocate_insert(index, count, calculate_growth(size_ + count), fill);
+            return;
+        }
+
+        pointer gap = data_ + index;
+        size_type tail = size_ - index;
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            std::memmove(static_cast<void*>(gap + count), static_cast<const void*>(gap), tail * sizeof(T));
+            try
+            {
+                fill(gap);
+            } catch (...)
+            {
+                std::memmove(static_cast<void*>(gap), static_cast<const void*>(gap + count), tail * sizeof(T));
+                throw;
+            }
+        } else {
+            // relocate the tail backwards into the raw slots past the end
+            size_type moved = 0;
+            try
+            {
+                for (; moved < tail; ++moved)
+                {
+                    pointer from = data_ + size_ - 1 - moved;
+                    construct(from + count, std::move(*from));
+                    destroy(from);
+                }
+                fill(gap);
+            } catch (...)
+            {
+                // bring the relocated tail back so [0, size_) is intact again
+                for (size_type i = tail - moved; i < tail; ++i)
+                {
+                    construct(gap + i, std::move(gap[i + count]));
+                    destroy(gap + i + count);
+                }
+                throw;
+            }
+        }
+        size_ += count;
+    }
+
+    template <typename T, std::size_t N, typename Allocator>
+    typename my_small_vector<T, N, Allocator>::size_type my_small_vector<T, N, Allocator>::calculate_growth(
+        size_type new_size) const {
+        const size_type max_sz = max_size();
+
+        if (new_size > max_sz)
+        {
+            throw std::length_error("my_small_vector::calculate_growth: maximum size exceeded");
+        }
+
+        size_type new_capacity = default_growth::next_capacity<T>(capacity_, new_size);
+
+        return std::clamp(new_capacity, new_size, max_sz);
+    }
+
+    // Non-member functions
+    template <typename T, std::size_t N, typename Allocator>
+    void swap(my_small_vector<T, N, Allocator>& lhs, my_small_vector<T, N, Allocator>& rhs) {
+        lhs.swap(rhs);
+    }
+}; // namespace myVector
+
+#endif // MY_SMALL_VECTOR_H
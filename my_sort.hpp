@@ -0,0 +1,382 @@
+#ifndef MY_SORT_H
+#define MY_SORT_H
+
+// parallel_sort and parallel_stable_sort for my_vector, on the thread pool from my_parallel.hpp.
+// The vector is cut into one run per thread, the runs are sorted side by side and then merged
+// pairwise through a scratch my_vector, every merge split into pieces along the merge path so all
+// threads stay busy down to the last round. Integral and floating-point elements compared with
+// std::less or std::greater skip the comparisons: they get an LSD radix sort, 8 bits per pass,
+// with per-thread histograms and a pass skipped when all keys share its digit.
+// If the comparison throws, the first exception is rethrown and the elements are left valid but in
+// unspecified order and possibly moved-from, as after a throwing move.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <execution>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "my_parallel.hpp"
+#include "my_vector.hpp"
+
+namespace myVector
+{
+    // At most this many threads take part in one sort, 0 for the whole pool
+    inline std::atomic<std::size_t> parallel_sort_threads{0};
+
+    template <typename T, typename Allocator, typename GrowthPolicy, typename Compare = std::less<>>
+    void parallel_sort(my_vector<T, Allocator, GrowthPolicy>& v, Compare comp = {});
+
+    // Equivalent elements keep their relative order
+    template <typename T, typename Allocator, typename GrowthPolicy, typename Compare = std::less<>>
+    void parallel_stable_sort(my_vector<T, Allocator, GrowthPolicy>& v, Compare comp = {});
+
+    namespace detail
+    {
+        // below this many elements a comparison sort beats counting 256 buckets per pass
+        inline constexpr std::size_t radix_sort_min_size = 2048;
+
+        template <typename T>
+        concept radix_key = (std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_same_v<T, float> ||
+                            std::is_same_v<T, double>;
+
+        template <typename T, typename Compare>
+        inline constexpr bool ascending_order = std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>>;
+
+        template <typename T, typename Compare>
+        inline constexpr bool descending_order = std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<T>>;
+
+        template <typename T, typename Compare>
+        inline constexpr bool radix_sortable = radix_key<T> && (ascending_order<T, Compare> || descending_order<T, Compare>);
+
+        template <typename T>
+        using radix_bits = std::make_unsigned_t<std::conditional_t<std::is_floating_point_v<T>,
+                                                                   std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>, T>>;
+
+        // Maps an element to an unsigned key whose order is the element order: signed values get
+        // their sign bit flipped, negative floats all of their bits. -0.0 becomes +0.0 because the
+        // two compare equal, and a stable sort must not reorder them.
+        template <typename T, bool Descending>
+        radix_bits<T> radix_key_of(T value) noexcept {
+            using U = radix_bits<T>;
+            constexpr U sign = U{1} << (sizeof(U) * CHAR_BIT - 1);
+            U key;
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                key = value == T{0} ? U{0} : std::bit_cast<U>(value);
+                key = (key & sign) ? U(~key) : U(key | sign);
+            } else if constexpr (std::is_signed_v<T>) {
+                key = static_cast<U>(value) ^ sign;
+            } else {
+                key = value;
+            }
+            if constexpr (Descending)
+            {
+                key = U(~key);
+            }
+            return key;
+        }
+
+        inline void rethrow_first(const std::vector<std::exception_ptr>& errors) {
+            auto failed = std::find_if(errors.begin(), errors.end(), [](const std::exception_ptr& e) { return e != nullptr; });
+            if (failed != errors.end())
+            {
+                std::rethrow_exception(*failed);
+            }
+        }
+
+        // Threads for a sort of n elements: one unless the range is worth splitting
+        inline std::size_t sort_parts(std::size_t n, std::size_t element_size) {
+            if (n * element_size < parallel_threshold_bytes.load(std::memory_order_relaxed))
+            {
+                return 1;
+            }
+            const std::size_t limit = parallel_sort_threads.load(std::memory_order_relaxed);
+            const std::size_t threads = limit == 0 ? thread_pool::instance().concurrency() : limit;
+            return std::max<std::size_t>(1, std::min(threads, n / 1024));
+        }
+
+        // Runs task(i, first, last) for `parts` nearly equal slices of [0, n)
+        template <typename Task>
+        void for_each_slice(std::size_t n, std::size_t parts, Task task) {
+            rethrow_first(thread_pool::instance().run(parts, [&](std::size_t i) { task(i, i * n / parts, (i + 1) * n / parts); }));
+        }
+
+        template <typename T>
+        void parallel_move(T* from, T* to, std::size_t n, std::size_t parts) {
+            for_each_slice(n, parts, [&](std::size_t, std::size_t first, std::size_t last) {
+                std::move(from + first, from + last, to + first);
+            });
+        }
+
+        // LSD radix sort of data, scratch holds n elements to scatter into and is overwritten
+        template <bool Descending, typename T>
+        void radix_sort(T* data, T* scratch, std::size_t n, std::size_t parts) {
+            using histogram = std::array<std::size_t, 256>;
+            constexpr std::size_t passes = sizeof(T);
+            constexpr std::size_t line = 64 / sizeof(T);
+            auto digit = [](const T& value, std::size_t pass) {
+                return static_cast<std::size_t>(radix_key_of<T, Descending>(value) >> (pass * CHAR_BIT)) & 0xff;
+            };
+
+            // the digit totals don't depend on the order, so one read finds the passes that would move nothing
+            std::vector<std::array<histogram, passes>> all_counts(parts);
+            for_each_slice(n, parts, [&](std::size_t part, std::size_t first, std::size_t last) {
+                auto& counts = all_counts[part];
+                for (histogram& h : counts)
+                {
+                    h.fill(0);
+                }
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    const auto key = radix_key_of<T, Descending>(data[i]);
+                    for (std::size_t pass = 0; pass < passes; ++pass)
+                    {
+                        ++counts[pass][static_cast<std::size_t>(key >> (pass * CHAR_BIT)) & 0xff];
+                    }
+                }
+            });
+
+            T*                     src = data;
+            T*                     dst = scratch;
+            bool                   counted = true; // all_counts still describes src
+            std::vector<histogram> next(parts);
+            for (std::size_t pass = 0; pass < passes; ++pass)
+            {
+                bool uniform = false;
+                for (std::size_t d = 0; d < 256 && !uniform; ++d)
+                {
+                    std::size_t total = 0;
+                    for (const auto& counts : all_counts)
+                    {
+                        total += counts[pass][d];
+                    }
+                    uniform = total == n;
+                }
+                if (uniform)
+                {
+                    continue;
+                }
+
+                if (counted)
+                {
+                    for (std::size_t part = 0; part < parts; ++part)
+                    {
+                        next[part] = all_counts[part][pass];
+                    }
+                } else {
+                    for_each_slice(n, parts, [&](std::size_t part, std::size_t first, std::size_t last) {
+                        next[part].fill(0);
+                        for (std::size_t i = first; i < last; ++i)
+                        {
+                            ++next[part][digit(src[i], pass)];
+                        }
+                    });
+                }
+
+                // bucket d of part p starts after all smaller digits and after bucket d of parts < p
+                std::size_t offset = 0;
+                for (std::size_t d = 0; d < 256; ++d)
+                {
+                    for (histogram& h : next)
+                    {
+                        offset += std::exchange(h[d], offset);
+                    }
+                }
+
+                // each bucket gathers a cache line before it is written out: with evenly sized buckets
+                // the 256 output streams sit a multiple of 4 KiB apart and would evict each other
+                for_each_slice(n, parts, [&](std::size_t part, std::size_t first, std::size_t last) {
+                    histogram&                            position = next[part];
+                    std::array<std::array<T, line>, 256> pending;
+                    std::array<std::size_t, 256>          filled{};
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        const std::size_t d = digit(src[i], pass);
+                        pending[d][filled[d]++] = src[i];
+                        if (filled[d] == line)
+                        {
+                            std::memcpy(dst + position[d], pending[d].data(), sizeof(pending[d]));
+                            position[d] += line;
+                            filled[d] = 0;
+                        }
+                    }
+                    for (std::size_t d = 0; d < 256; ++d)
+                    {
+                        std::memcpy(dst + position[d], pending[d].data(), filled[d] * sizeof(T));
+                    }
+                });
+                std::swap(src, dst);
+                counted = false;
+            }
+
+            if (src != data)
+            {
+                parallel_move(src, data, n, parts);
+            }
+        }
+
+        // Number of elements of a that come before output position k when a and b are merged
+        // stably, found by binary search along the merge path
+        template <typename T, typename Compare>
+        std::size_t merge_path(const T* a, std::size_t a_size, const T* b, std::size_t b_size, std::size_t k, Compare& comp) {
+            std::size_t lo = k > b_size ? k - b_size : 0;
+            std::size_t hi = std::min(k, a_size);
+            while (lo < hi)
+            {
+                const std::size_t i = lo + (hi - lo) / 2;
+                if (!comp(b[k - i - 1], a[i]))
+                {
+                    lo = i + 1;
+                } else {
+                    hi = i;
+                }
+            }
+            return lo;
+        }
+
+        // Merges the sorted runs [bounds[i], bounds[i + 1]) pairwise until one is left, moving the
+        // elements back and forth between src and other. Returns the buffer holding the result.
+        template <typename T, typename Compare>
+        T* merge_runs(T* src, T* other, std::vector<std::size_t> bounds, std::size_t threads, Compare& comp) {
+            struct piece
+            {
+                std::size_t first, middle, last; // the two runs
+                std::size_t from, to;            // output positions relative to first
+                std::size_t a_from, a_to;        // where the merge path crosses them
+            };
+
+            const std::size_t n = bounds.back();
+            while (bounds.size() > 2)
+            {
+                std::vector<piece>       pieces;
+                std::vector<std::size_t> merged{0};
+                for (std::size_t i = 0; i + 1 < bounds.size(); i += 2)
+                {
+                    const std::size_t first = bounds[i];
+                    const std::size_t middle = bounds[i + 1];
+                    const std::size_t last = i + 2 < bounds.size() ? bounds[i + 2] : middle;
+                    // the share of the threads this pair's length is worth, the last round splits n ways
+                    const std::size_t count = std::max<std::size_t>(1, ((last - first) * threads + n - 1) / n);
+                    for (std::size_t j = 0; j < count; ++j)
+                    {
+                        pieces.push_back({first, middle, last, j * (last - first) / count, (j + 1) * (last - first) / count, 0, 0});
+                    }
+                    merged.push_back(last);
+                }
+
+                // all the searches finish before any merge moves elements out from under its neighbours
+                rethrow_first(thread_pool::instance().run(pieces.size(), [&](std::size_t i) {
+                    piece& p = pieces[i];
+                    const T* a = src + p.first;
+                    const T* b = src + p.middle;
+                    p.a_from = merge_path(a, p.middle - p.first, b, p.last - p.middle, p.from, comp);
+                    p.a_to = merge_path(a, p.middle - p.first, b, p.last - p.middle, p.to, comp);
+                }));
+
+                T* const dst = other;
+                rethrow_first(thread_pool::instance().run(pieces.size(), [&](std::size_t i) {
+                    const piece& p = pieces[i];
+                    T* const     a = src + p.first;
+                    T* const     b = src + p.middle;
+                    std::merge(std::make_move_iterator(a + p.a_from), std::make_move_iterator(a + p.a_to),
+                               std::make_move_iterator(b + (p.from - p.a_from)), std::make_move_iterator(b + (p.to - p.a_to)),
+                               dst + p.first + p.from, comp);
+                }));
+
+                other = src;
+                src = dst;
+                bounds = std::move(merged);
+            }
+            return src;
+        }
+
+        template <bool Stable, typename T, typename Allocator, typename GrowthPolicy, typename Compare>
+        void sort(my_vector<T, Allocator, GrowthPolicy>& v, Compare& comp) {
+            using vector_type = my_vector<T, Allocator, GrowthPolicy>;
+            const std::size_t n = v.size();
+            const std::size_t parts = sort_parts(n, sizeof(T));
+
+            // one read, and random data stops at its first descent
+            if (std::is_sorted(v.data(), v.data() + n, comp))
+            {
+                return;
+            }
+
+            if constexpr (radix_sortable<T, Compare>)
+            {
+                if (n >= radix_sort_min_size)
+                {
+                    vector_type scratch(v.get_allocator());
+                    scratch.resize_default_init(n);
+                    radix_sort<descending_order<T, Compare>>(v.data(), scratch.data(), n, parts);
+                    return;
+                }
+            }
+
+            auto sort_run = [&comp](T* first, T* last) {
+                if constexpr (Stable)
+                {
+                    std::stable_sort(first, last, comp);
+                } else {
+                    std::sort(first, last, comp);
+                }
+            };
+            if (parts == 1)
+            {
+                sort_run(v.data(), v.data() + n);
+                return;
+            }
+
+            std::vector<std::size_t> bounds(parts + 1);
+            for (std::size_t i = 0; i <= parts; ++i)
+            {
+                bounds[i] = i * n / parts;
+            }
+            for_each_slice(n, parts, [&](std::size_t, std::size_t first, std::size_t last) { sort_run(v.data() + first, v.data() + last); });
+
+            // the scratch buffer must hold live objects for the merges to move-assign into: trivial
+            // types are fine uninitialized, others are moved over and the merging starts from there
+            T*     src = v.data();
+            T*     other;
+            vector_type scratch(v.get_allocator());
+            if constexpr (std::is_trivially_copyable_v<T> && std::is_trivially_default_constructible_v<T>)
+            {
+                scratch.resize_default_init(n);
+                other = scratch.data();
+            } else {
+                scratch = vector_type(std::execution::par, std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()),
+                                 v.get_allocator());
+                src = scratch.data();
+                other = v.data();
+            }
+
+            T* const result = merge_runs(src, other, std::move(bounds), parts, comp);
+            if (result != v.data())
+            {
+                parallel_move(result, v.data(), n, parts);
+            }
+        }
+    } // namespace detail
+
+    template <typename T, typename Allocator, typename GrowthPolicy, typename Compare>
+    void parallel_sort(my_vector<T, Allocator, GrowthPolicy>& v, Compare comp) {
+        detail::sort<false>(v, comp);
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy, typename Compare>
+    void parallel_stable_sort(my_vector<T, Allocator, GrowthPolicy>& v, Compare comp) {
+        detail::sort<true>(v, comp);
+    }
+}; // namespace myVector
+
+#endif // MY_SORT_H
@@ -2,149 +2,315 @@
 #define MY_VECTOR_H
 
 #include <algorithm>
+#include <compare>
+#include <concepts>
 #include <cstddef>
+#include <cstring>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
 
+#include "my_compare.hpp"
+#include "my_growth_policies.hpp"
+#include "my_parallel.hpp"
+#include "my_vector_checks.hpp"
+#include "my_vector_stats.hpp"
+
 namespace myVector
 {
+    // Relocation = move-construct into new storage + destroy the source.
+    // For trivially relocatable types this pair is equivalent to a plain byte copy,
+    // so growth paths can memcpy the whole buffer and skip the destructor loop.
+    // Specialize for your own types to opt in (the type must not store pointers to itself).
+    template <typename T>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T>
+    {};
+
+    template <typename T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    template <typename T>
+    struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type
+    {};
+
     template <typename T>
+    struct is_trivially_relocatable<std::allocator<T>> : std::true_type
+    {};
+
+    // Allocators that can resize a block in place, e.g. realloc_allocator from my_allocators.hpp
+    template <typename Allocator>
+    concept reallocating_allocator = requires(Allocator& alloc, typename Allocator::value_type* ptr, std::size_t n) {
+        { alloc.reallocate(ptr, n, n) } -> std::same_as<typename Allocator::value_type*>;
+    };
+
+    // Iterators that can be split into chunks by index, by their iterator_category
+    template <typename It>
+    concept legacy_random_access_iterator =
+        std::derived_from<typename std::iterator_traits<It>::iterator_category, std::random_access_iterator_tag>;
+
+    namespace detail
+    {
+        // The memcpy behind the bitwise copy and relocation paths. Once those are inlined into a
+        // caller, GCC 12 can't always tell that a branch copying into a full buffer is never taken
+        // and reports -Wstringop-overflow for it; the callers keep their copies within capacity.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wstringop-overflow"
+#endif
+        inline void copy_bytes(void* dest, const void* src, std::size_t bytes) noexcept {
+            std::memcpy(dest, src, bytes);
+        }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+    } // namespace detail
+
+    template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = default_growth>
+    class my_vector;
+
+    // my_vector is just {allocator, pointer, size, capacity}, nothing points back into the object
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    struct is_trivially_relocatable<my_vector<T, Allocator, GrowthPolicy>> : is_trivially_relocatable<Allocator>
+    {};
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
     class my_vector
     {
+        using alloc_traits = std::allocator_traits<Allocator>;
+        static_assert(std::is_same_v<typename Allocator::value_type, T>, "my_vector: Allocator::value_type must be T");
+        static_assert(std::is_same_v<typename alloc_traits::pointer, T*>, "my_vector: fancy pointers are not supported");
+
+        // growth can hand the whole block to the allocator instead of relocating it ourselves
+        static constexpr bool grows_in_place = reallocating_allocator<Allocator> && is_trivially_relocatable_v<T>;
+
+        // no-ops unless MY_VECTOR_INSTRUMENTATION is set, see my_vector_stats.hpp
+        using instrumentation = vector_instrumentation<my_vector>;
+
+        // multi-pass ranges can be counted up front, single-pass ones have to grow as they go
+        template <typename It>
+        static constexpr bool is_forward_iterator =
+            std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+
       public:
         using value_type = T;
+        using allocator_type = Allocator;
+        using growth_policy = GrowthPolicy;
         using size_type = std::size_t;
         using difference_type = std::ptrdiff_t;
         using reference = value_type&;
         using const_reference = const value_type&;
         using pointer = value_type*;
         using const_pointer = const value_type*;
-        bool operator==(const my_vector& other) const = default; // for tests
-
 
       private:
-        pointer   data_;     // pointer to data buffer
-        size_type size_;     // number of elements
-        size_type capacity_; // buffer size in elements
+        [[no_unique_address]] allocator_type alloc_;    // where the buffer comes from
+        pointer                              data_;     // pointer to data buffer
+        size_type                            size_;     // number of elements
+        size_type                            capacity_; // buffer size in elements
+        [[no_unique_address]] buffer_generation generation_; // stales iterators, empty unless MY_VECTOR_ASSERTIONS
 
         // Helper method declarations
-        static pointer allocate(size_type n);
-        void           deallocate();
-        static void    deallocate(pointer ptr, size_type n);
-        static void    destroy_range(pointer first, pointer last);
-        void           allocate_and_fill(size_type n, const T& value);
+        constexpr pointer allocate(size_type n);
+        constexpr void    deallocate();
+        constexpr void    deallocate(pointer ptr, size_type n);
+        template <typename... Args>
+        constexpr void construct(pointer ptr, Args&&... args);
+        constexpr void destroy(pointer ptr) noexcept;
+        constexpr void destroy_range(pointer first, pointer last) noexcept;
+        constexpr void relocate_range(pointer first, pointer last, pointer dest);
+        constexpr void finish_relocation(pointer first, pointer last) noexcept;
+        constexpr void steal(my_vector& other) noexcept;
+        constexpr auto make_iterator(pointer ptr) noexcept;
+        constexpr auto make_iterator(const_pointer ptr) const noexcept;
+        constexpr void construct_n(pointer dest, size_type n, const T& value);
+        template <typename InputIt>
+        constexpr void construct_copy(pointer dest, InputIt first, size_type count);
+        template <typename InputIt>
+        constexpr void append_counted(InputIt first, size_type count);
+        constexpr void allocate_and_fill(size_type n, const T& value);
         template <typename InputIt>
-        void                    allocate_and_copy(InputIt first, InputIt last);
-        void                    reallocate(size_type new_capacity);
-        void                    reallocate_insert(size_type index, const T& value, size_type new_capacity);
-        void                    shift_right(size_type index, size_type count);
-        void                    shift_left(size_type index, size_type count);
-        [[nodiscard]] size_type calculate_growth(size_type new_size) const;
+        constexpr void allocate_and_copy(InputIt first, InputIt last);
+        constexpr void reallocate(size_type new_capacity);
+        template <typename Fill>
+        constexpr void                    reallocate_insert(size_type index, size_type count, size_type new_capacity, Fill&& fill);
+        constexpr void                    shift_right(size_type index, size_type count);
+        constexpr void                    shift_left(size_type index, size_type count);
+        template <typename Fill>
+        void parallel_construct(pointer dest, size_type n, Fill fill);
+        template <execution_policy Policy, typename Fill>
+        void assign_filled(size_type n, Fill fill);
+        [[nodiscard]] constexpr size_type calculate_growth(size_type new_size) const;
 
       public:
         // Constructor declarations
-        my_vector() noexcept;
-        explicit my_vector(size_type n, const T& value = T());
+        constexpr my_vector() noexcept(noexcept(Allocator()));
+        constexpr explicit my_vector(const Allocator& alloc) noexcept;
+        constexpr explicit my_vector(size_type n, const T& value = T(), const Allocator& alloc = Allocator());
         template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
-        my_vector(InputIt first, InputIt last);
-        my_vector(std::initializer_list<T> init);
-        my_vector(const my_vector& other);
-        my_vector(my_vector&& other) noexcept;
+        constexpr my_vector(InputIt first, InputIt last, const Allocator& alloc = Allocator());
+        constexpr my_vector(std::initializer_list<T> init, const Allocator& alloc = Allocator());
+        constexpr my_vector(const my_vector& other);
+        constexpr my_vector(const my_vector& other, const Allocator& alloc);
+        constexpr my_vector(my_vector&& other) noexcept;
+        constexpr my_vector(my_vector&& other, const Allocator& alloc);
+
+        // Parallel construction (my_parallel.hpp): with std::execution::par or par_unseq and at least
+        // parallel_threshold_bytes of elements, the elements are built chunk by chunk on the thread pool
+        template <execution_policy Policy>
+        my_vector(Policy&& policy, size_type n, const T& value, const Allocator& alloc = Allocator());
+        template <execution_policy Policy, legacy_random_access_iterator RandomIt>
+        my_vector(Policy&& policy, RandomIt first, RandomIt last, const Allocator& alloc = Allocator());
+        template <execution_policy Policy>
+        my_vector(Policy&& policy, const my_vector& other);
 
         // Destructor declaration
-        ~my_vector();
+        constexpr ~my_vector();
 
         // Operator declarations
-        my_vector& operator=(const my_vector& other);
-        my_vector& operator=(my_vector&& other) noexcept;
-        my_vector& operator=(std::initializer_list<T> ilist);
+        constexpr my_vector& operator=(const my_vector& other);
+        constexpr my_vector& operator=(my_vector&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                                                   alloc_traits::is_always_equal::value);
+        constexpr my_vector& operator=(std::initializer_list<T> ilist);
+
+        [[nodiscard]] constexpr allocator_type get_allocator() const noexcept;
 
         // Element access
-        reference       operator[](size_type pos);
-        const_reference operator[](size_type pos) const;
-        reference       at(size_type pos);
-        const_reference at(size_type pos) const;
-        reference       front();
-        const_reference front() const;
-        reference       back();
-        const_reference back() const;
-        pointer         data() noexcept;
-        const_pointer   data() const noexcept;
+        constexpr reference       operator[](size_type pos);
+        constexpr const_reference operator[](size_type pos) const;
+        constexpr reference       at(size_type pos);
+        constexpr const_reference at(size_type pos) const;
+        constexpr reference       front();
+        constexpr const_reference front() const;
+        constexpr reference       back();
+        constexpr const_reference back() const;
+        constexpr pointer         data() noexcept;
+        constexpr const_pointer   data() const noexcept;
 
         // Capacity
-        [[nodiscard]] bool      is_empty() const noexcept;
-        [[nodiscard]] size_type size() const noexcept;
-        static size_type        max_size() noexcept;
-        void                    reserve(size_type new_cap);
-        [[nodiscard]] size_type capacity() const noexcept;
-        void                    shrink_to_fit();
+        [[nodiscard]] constexpr bool      is_empty() const noexcept;
+        [[nodiscard]] constexpr size_type size() const noexcept;
+        [[nodiscard]] constexpr size_type max_size() const noexcept;
+        constexpr void                    reserve(size_type new_cap);
+        [[nodiscard]] constexpr size_type capacity() const noexcept;
+        constexpr void                    shrink_to_fit();
 
         // Modifiers
-        void clear() noexcept;
-        void push_back(const T& value);
-        void push_back(T&& value);
+        constexpr void clear() noexcept;
+        constexpr void push_back(const T& value);
+        constexpr void push_back(T&& value);
         template <typename... Args>
-        reference emplace_back(Args&&... args);
-        void      pop_back();
-        void      resize(size_type new_size);
-        void      resize(size_type new_size, const T& value);
-        void      assign(size_type n, const T& value);
+        constexpr reference emplace_back(Args&&... args);
+        constexpr void      pop_back();
+        constexpr void      resize(size_type new_size);
+        constexpr void      resize(size_type new_size, const T& value);
+        constexpr void      resize_default_init(size_type new_size);
+        template <typename Operation>
+        constexpr void resize_and_overwrite(size_type n, Operation op);
+        constexpr void      assign(size_type n, const T& value);
+        template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        constexpr void assign(InputIt first, InputIt last);
+        constexpr void assign(std::initializer_list<T> ilist);
+
+        // Parallel versions, same guarantees as the sequential ones
+        template <execution_policy Policy>
+        void assign(Policy&& policy, size_type n, const T& value);
+        template <execution_policy Policy, legacy_random_access_iterator RandomIt>
+        void assign(Policy&& policy, RandomIt first, RandomIt last);
+        template <execution_policy Policy, legacy_random_access_iterator RandomIt, typename UnaryOp>
+        void assign_transformed(Policy&& policy, RandomIt first, RandomIt last, UnaryOp op);
+        template <execution_policy Policy>
+        void resize(Policy&& policy, size_type new_size, const T& value);
+
+        // Bulk append: one capacity check, then a tight construct loop (memcpy when possible)
+        template <std::ranges::input_range R>
+        constexpr void append_range(R&& range);
         template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
-        void assign(InputIt first, InputIt last);
-        void assign(std::initializer_list<T> ilist);
-        void swap(my_vector& other) noexcept;
+        constexpr void append(InputIt first, InputIt last);
+        constexpr void append_n(size_type n, const T& value);
 
-        // Spaceship operator
-        auto operator<=>(const my_vector& other) const;
+        constexpr void swap(my_vector& other) noexcept(alloc_traits::propagate_on_container_swap::value ||
+                                             alloc_traits::is_always_equal::value);
 
+        // Comparison operators
+        constexpr bool operator==(const my_vector& other) const;
+        constexpr auto operator<=>(const my_vector& other) const;
+
+        // A contiguous iterator (iterator_concept, and std::to_address through operator->), so
+        // std::span, the ranges algorithms and construct_copy see plain memory behind it
         template <typename PtrType, typename RefType>
         class base_iterator
         {
           public:
             using iterator_category = std::random_access_iterator_tag;
+            using iterator_concept = std::contiguous_iterator_tag;
             using value_type = T;
+            using element_type = std::remove_reference_t<RefType>;
             using difference_type = std::ptrdiff_t;
             using pointer = PtrType;
             using reference = RefType;
 
-            base_iterator() : ptr_(nullptr) {}
-            explicit base_iterator(pointer ptr) : ptr_(ptr) {}
+            constexpr base_iterator() : ptr_(nullptr) {}
+            constexpr explicit base_iterator(pointer ptr) : ptr_(ptr) {}
 
+            // iterator converts to const_iterator, not the other way around
             template <typename OtherPtr, typename OtherRef>
-            explicit base_iterator(const base_iterator<OtherPtr, OtherRef>& other) : ptr_(other.ptr_) {}
+                requires std::is_convertible_v<OtherPtr, PtrType>
+            constexpr base_iterator(const base_iterator<OtherPtr, OtherRef>& other) : ptr_(other.ptr_), stamp_(other.stamp_) {}
 
-            reference operator*() const { return *ptr_; }
-            pointer   operator->() const { return ptr_; }
+            // with MY_VECTOR_ASSERTIONS, dereferencing after the buffer was reallocated or freed aborts
+            constexpr reference operator*() const {
+                MY_VECTOR_ASSERT(stamp_.valid());
+                return *ptr_;
+            }
+            constexpr pointer operator->() const {
+                MY_VECTOR_ASSERT(stamp_.valid());
+                return ptr_;
+            }
 
             // clang-format off
-            base_iterator& operator++() { ++ptr_; return *this; }
-            base_iterator operator++(int) { base_iterator tmp = *this; ++ptr_; return tmp; }
+            constexpr base_iterator& operator++() { ++ptr_; return *this; }
+            constexpr base_iterator operator++(int) { base_iterator tmp = *this; ++ptr_; return tmp; }
 
-            base_iterator& operator--() { --ptr_; return *this; }
-            base_iterator operator--(int) { base_iterator tmp = *this; --ptr_; return tmp; }
+            constexpr base_iterator& operator--() { --ptr_; return *this; }
+            constexpr base_iterator operator--(int) { base_iterator tmp = *this; --ptr_; return tmp; }
 
-            base_iterator& operator+=(difference_type n) { ptr_ += n; return *this; }
-            base_iterator& operator-=(difference_type n) { ptr_ -= n; return *this; }
+            constexpr base_iterator& operator+=(difference_type n) { ptr_ += n; return *this; }
+            constexpr base_iterator& operator-=(difference_type n) { ptr_ -= n; return *this; }
             // clang-format on
 
-            base_iterator operator+(difference_type n) const { return base_iterator(ptr_ + n); }
-            base_iterator operator-(difference_type n) const { return base_iterator(ptr_ - n); }
-
-            difference_type operator-(const base_iterator& other) const { return ptr_ - other.ptr_; }
+            constexpr base_iterator operator+(difference_type n) const { return base_iterator(ptr_ + n, stamp_); }
+            constexpr base_iterator operator-(difference_type n) const { return base_iterator(ptr_ - n, stamp_); }
+            friend constexpr base_iterator operator+(difference_type n, const base_iterator& it) { return it + n; }
 
-            reference operator[](difference_type n) const { return ptr_[n]; }
+            constexpr reference operator[](difference_type n) const {
+                MY_VECTOR_ASSERT(stamp_.valid());
+                return ptr_[n];
+            }
 
-            auto operator<=>(const base_iterator& other) const = default;
+            // between iterator and const_iterator too
+            template <typename OtherPtr, typename OtherRef>
+            constexpr difference_type operator-(const base_iterator<OtherPtr, OtherRef>& other) const { return ptr_ - other.ptr_; }
+            template <typename OtherPtr, typename OtherRef>
+            constexpr bool operator==(const base_iterator<OtherPtr, OtherRef>& other) const { return ptr_ == other.ptr_; }
+            template <typename OtherPtr, typename OtherRef>
+            constexpr std::strong_ordering operator<=>(const base_iterator<OtherPtr, OtherRef>& other) const {
+                return std::compare_three_way{}(ptr_, other.ptr_);
+            }
 
           private:
-            pointer ptr_;
+            constexpr base_iterator(pointer ptr, iterator_stamp stamp) : ptr_(ptr), stamp_(stamp) {}
+
+            pointer                              ptr_;
+            [[no_unique_address]] iterator_stamp stamp_; // empty unless MY_VECTOR_ASSERTIONS
 
             template <typename, typename>
             friend class base_iterator;
-            friend class my_vector<T>;
+            friend class my_vector;
         };
 
         using iterator = base_iterator<T*, T&>;
@@ -154,55 +320,63 @@ namespace myVector
         using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
         // Iterators
-        iterator               begin() noexcept;
-        const_iterator         begin() const noexcept;
-        const_iterator         cbegin() const noexcept;
-        iterator               end() noexcept;
-        const_iterator         end() const noexcept;
-        const_iterator         cend() const noexcept;
-        reverse_iterator       rbegin() noexcept;
-        const_reverse_iterator rbegin() const noexcept;
-        const_reverse_iterator crbegin() const noexcept;
-        reverse_iterator       rend() noexcept;
-        const_reverse_iterator rend() const noexcept;
-        const_reverse_iterator crend() const noexcept;
+        constexpr iterator               begin() noexcept;
+        constexpr const_iterator         begin() const noexcept;
+        constexpr const_iterator         cbegin() const noexcept;
+        constexpr iterator               end() noexcept;
+        constexpr const_iterator         end() const noexcept;
+        constexpr const_iterator         cend() const noexcept;
+        constexpr reverse_iterator       rbegin() noexcept;
+        constexpr const_reverse_iterator rbegin() const noexcept;
+        constexpr const_reverse_iterator crbegin() const noexcept;
+        constexpr reverse_iterator       rend() noexcept;
+        constexpr const_reverse_iterator rend() const noexcept;
+        constexpr const_reverse_iterator crend() const noexcept;
 
         // Modifiers
-        iterator insert(const_iterator pos, const T& value);
-        iterator insert(const_iterator pos, T&& value);
-        iterator insert(const_iterator pos, size_type n, const T& value);
+        constexpr iterator insert(const_iterator pos, const T& value);
+        constexpr iterator insert(const_iterator pos, T&& value);
+        constexpr iterator insert(const_iterator pos, size_type n, const T& value);
         template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
-        iterator insert(const_iterator pos, InputIt first, InputIt last);
-        iterator insert(const_iterator pos, std::initializer_list<T> ilist);
-        iterator erase(const_iterator pos);
-        iterator erase(const_iterator first, const_iterator last);
+        constexpr iterator insert(const_iterator pos, InputIt first, InputIt last);
+        constexpr iterator insert(const_iterator pos, std::initializer_list<T> ilist);
+        constexpr iterator erase(const_iterator pos);
+        constexpr iterator erase(const_iterator first, const_iterator last);
     };
 
     // Constructor implementations
-    template <typename T>
-    my_vector<T>::my_vector() noexcept : data_(nullptr), size_(0), capacity_(0) {}
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr my_vector<T, Allocator, GrowthPolicy>::my_vector() noexcept(noexcept(Allocator())) : my_vector(Allocator()) {}
 
-    template <typename T>
-    my_vector<T>::my_vector(size_type n, const T& value) : data_(nullptr), size_(0), capacity_(0) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr my_vector<T, Allocator, GrowthPolicy>::my_vector(const Allocator& alloc) noexcept :
+        alloc_(alloc), data_(nullptr), size_(0), capacity_(0) {}
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr my_vector<T, Allocator, GrowthPolicy>::my_vector(size_type n, const T& value, const Allocator& alloc) : my_vector(alloc) {
         if (n > 0)
         {
             allocate_and_fill(n, value);
         }
     }
 
-    template <typename T>
+    template <typename T, typename Allocator, typename GrowthPolicy>
     template <typename InputIt, typename>
-    my_vector<T>::my_vector(InputIt first, InputIt last) : data_(nullptr), size_(0), capacity_(0) {
+    constexpr my_vector<T, Allocator, GrowthPolicy>::my_vector(InputIt first, InputIt last, const Allocator& alloc) : my_vector(alloc) {
         assign(first, last);
     }
 
-    template <typename T>
-    my_vector<T>::my_vector(std::initializer_list<T> init) : data_(nullptr), size_(0), capacity_(0) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr my_vector<T, Allocator, GrowthPolicy>::my_vector(std::initializer_list<T> init, const Allocator& alloc) : my_vector(alloc) {
         assign(init.begin(), init.end());
     }
 
-    template <typename T>
-    my_vector<T>::my_vector(const my_vector& other) : data_(nullptr), size_(0), capacity_(0) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr my_vector<T, Allocator, GrowthPolicy>::my_vector(const my_vector& other) :
+        my_vector(other, alloc_traits::select_on_container_copy_construction(other.alloc_)) {}
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr my_vector<T, Allocator, GrowthPolicy>::my_vector(const my_vector& other, const Allocator& alloc) : my_vector(alloc) {
         if (other.size_ > 0)
         {
             allocate_and_copy(other.begin(), other.end());
@@ -210,72 +384,123 @@ namespace myVector
         }
     }
 
-    template <typename T>
-    my_vector<T>::my_vector(my_vector&& other) noexcept :
-        data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
-        other.data_ = nullptr;
-        other.size_ = 0;
-        other.capacity_ = 0;
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr my_vector<T, Allocator, GrowthPolicy>::my_vector(my_vector&& other) noexcept : my_vector(std::move(other.alloc_)) {
+        steal(other);
     }
 
+    // Takes the buffer only when `alloc` can free it, otherwise moves element by element
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr my_vector<T, Allocator, GrowthPolicy>::my_vector(my_vector&& other, const Allocator& alloc) : my_vector(alloc) {
+        if (alloc_traits::is_always_equal::value || alloc_ == other.alloc_)
+        {
+            steal(other);
+        } else if (other.size_ > 0) {
+            allocate_and_copy(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        }
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    template <execution_policy Policy>
+    my_vector<T, Allocator, GrowthPolicy>::my_vector(Policy&& policy, size_type n, const T& value, const Allocator& alloc) :
+        my_vector(alloc) {
+        // the delegated constructor has finished, so a throw from assign runs our destructor
+        assign(policy, n, value);
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    template <execution_policy Policy, legacy_random_access_iterator RandomIt>
+    my_vector<T, Allocator, GrowthPolicy>::my_vector(Policy&& policy, RandomIt first, RandomIt last, const Allocator& alloc) :
+        my_vector(alloc) {
+        assign(policy, first, last);
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    template <execution_policy Policy>
+    my_vector<T, Allocator, GrowthPolicy>::my_vector(Policy&& policy, const my_vector& other) :
+        my_vector(policy, other.data_, other.data_ + other.size_,
+                  alloc_traits::select_on_container_copy_construction(other.alloc_)) {}
+
     // Destructor implementation
-    template <typename T>
-    my_vector<T>::~my_vector() {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr my_vector<T, Allocator, GrowthPolicy>::~my_vector() {
+        instrumentation::on_destroy(capacity_ - size_);
         clear();
         deallocate();
     }
 
     // Assignment operators implementation
     // Copy
-    template <typename T>
-    my_vector<T>& my_vector<T>::operator=(const my_vector& other) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr my_vector<T, Allocator, GrowthPolicy>& my_vector<T, Allocator, GrowthPolicy>::operator=(const my_vector& other) {
         if (this != &other)
         {
-            my_vector tmp(other);
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+            {
+                if (!alloc_traits::is_always_equal::value && alloc_ != other.alloc_)
+                {
+                    // our buffer can only be freed by the allocator we are about to replace
+                    clear();
+                    deallocate();
+                }
+                alloc_ = other.alloc_;
+            }
+            my_vector tmp(other, alloc_);
             swap(tmp);
         }
         return *this;
     }
 
     // Move
-    template <typename T>
-    my_vector<T>& my_vector<T>::operator=(my_vector&& other) noexcept {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr my_vector<T, Allocator, GrowthPolicy>& my_vector<T, Allocator, GrowthPolicy>::operator=(my_vector&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
         if (this != &other)
         {
-            clear();
-            deallocate();
-
-            data_ = other.data_;
-            size_ = other.size_;
-            capacity_ = other.capacity_;
-
-            other.data_ = nullptr;
-            other.size_ = 0;
-            other.capacity_ = 0;
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+            {
+                clear();
+                deallocate();
+                alloc_ = std::move(other.alloc_);
+                steal(other);
+            } else {
+                if (alloc_traits::is_always_equal::value || alloc_ == other.alloc_)
+                {
+                    clear();
+                    deallocate();
+                    steal(other);
+                } else {
+                    // allocators stay put, so the elements have to move into our own storage
+                    assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                    other.clear();
+                }
+            }
         }
         return *this;
     }
 
     // Init list
-    template <typename T>
-    my_vector<T>& my_vector<T>::operator=(std::initializer_list<T> ilist) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr my_vector<T, Allocator, GrowthPolicy>& my_vector<T, Allocator, GrowthPolicy>::operator=(std::initializer_list<T> ilist) {
         assign(ilist.begin(), ilist.end());
         return *this;
     }
 
     // Element access implementations
-    template <typename T>
-    typename my_vector<T>::reference my_vector<T>::operator[](size_type pos) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::reference my_vector<T, Allocator, GrowthPolicy>::operator[](size_type pos) {
+        MY_VECTOR_ASSERT(pos < size_);
         return data_[pos];
     }
 
-    template <typename T>
-    typename my_vector<T>::const_reference my_vector<T>::operator[](size_type pos) const {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::const_reference my_vector<T, Allocator, GrowthPolicy>::operator[](size_type pos) const {
+        MY_VECTOR_ASSERT(pos < size_);
         return data_[pos];
     }
 
-    template <typename T>
-    typename my_vector<T>::reference my_vector<T>::at(size_type pos) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::reference my_vector<T, Allocator, GrowthPolicy>::at(size_type pos) {
         if (pos >= size_)
         {
             throw std::out_of_range("my_vector::at: index out of range");
@@ -283,8 +508,8 @@ namespace myVector
         return data_[pos];
     }
 
-    template <typename T>
-    typename my_vector<T>::const_reference my_vector<T>::at(size_type pos) const {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::const_reference my_vector<T, Allocator, GrowthPolicy>::at(size_type pos) const {
         if (pos >= size_)
         {
             throw std::out_of_range("my_vector::at: index out of range");
@@ -292,128 +517,137 @@ namespace myVector
         return data_[pos];
     }
 
-    template <typename T>
-    typename my_vector<T>::reference my_vector<T>::front() {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::reference my_vector<T, Allocator, GrowthPolicy>::front() {
+        MY_VECTOR_ASSERT(size_ > 0);
         return data_[0];
     }
 
-    template <typename T>
-    typename my_vector<T>::const_reference my_vector<T>::front() const {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::const_reference my_vector<T, Allocator, GrowthPolicy>::front() const {
+        MY_VECTOR_ASSERT(size_ > 0);
         return data_[0];
     }
 
-    template <typename T>
-    typename my_vector<T>::reference my_vector<T>::back() {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::reference my_vector<T, Allocator, GrowthPolicy>::back() {
+        MY_VECTOR_ASSERT(size_ > 0);
         return data_[size_ - 1];
     }
 
-    template <typename T>
-    typename my_vector<T>::const_reference my_vector<T>::back() const {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::const_reference my_vector<T, Allocator, GrowthPolicy>::back() const {
+        MY_VECTOR_ASSERT(size_ > 0);
         return data_[size_ - 1];
     }
 
-    template <typename T>
-    typename my_vector<T>::pointer my_vector<T>::data() noexcept {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::pointer my_vector<T, Allocator, GrowthPolicy>::data() noexcept {
         return data_;
     }
 
-    template <typename T>
-    typename my_vector<T>::const_pointer my_vector<T>::data() const noexcept {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::const_pointer my_vector<T, Allocator, GrowthPolicy>::data() const noexcept {
         return data_;
     }
 
     // Iterator implementations
-    template <typename T>
-    typename my_vector<T>::iterator my_vector<T>::begin() noexcept {
-        return iterator(data_);
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::iterator my_vector<T, Allocator, GrowthPolicy>::begin() noexcept {
+        return make_iterator(data_);
     }
 
-    template <typename T>
-    typename my_vector<T>::const_iterator my_vector<T>::begin() const noexcept {
-        return const_iterator(data_);
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::const_iterator my_vector<T, Allocator, GrowthPolicy>::begin() const noexcept {
+        return make_iterator(data_);
     }
 
-    template <typename T>
-    typename my_vector<T>::const_iterator my_vector<T>::cbegin() const noexcept {
-        return const_iterator(data_);
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::const_iterator my_vector<T, Allocator, GrowthPolicy>::cbegin() const noexcept {
+        return make_iterator(data_);
     }
 
-    template <typename T>
-    typename my_vector<T>::iterator my_vector<T>::end() noexcept {
-        return iterator(data_ + size_);
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::iterator my_vector<T, Allocator, GrowthPolicy>::end() noexcept {
+        return make_iterator(data_ + size_);
     }
 
-    template <typename T>
-    typename my_vector<T>::const_iterator my_vector<T>::end() const noexcept {
-        return const_iterator(data_ + size_);
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::const_iterator my_vector<T, Allocator, GrowthPolicy>::end() const noexcept {
+        return make_iterator(data_ + size_);
     }
 
-    template <typename T>
-    typename my_vector<T>::const_iterator my_vector<T>::cend() const noexcept {
-        return const_iterator(data_ + size_);
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::const_iterator my_vector<T, Allocator, GrowthPolicy>::cend() const noexcept {
+        return make_iterator(data_ + size_);
     }
 
-    template <typename T>
-    typename my_vector<T>::reverse_iterator my_vector<T>::rbegin() noexcept {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::reverse_iterator my_vector<T, Allocator, GrowthPolicy>::rbegin() noexcept {
         return reverse_iterator(end());
     }
 
-    template <typename T>
-    typename my_vector<T>::const_reverse_iterator my_vector<T>::rbegin() const noexcept {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::const_reverse_iterator my_vector<T, Allocator, GrowthPolicy>::rbegin() const noexcept {
         return const_reverse_iterator(end());
     }
 
-    template <typename T>
-    typename my_vector<T>::const_reverse_iterator my_vector<T>::crbegin() const noexcept {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::const_reverse_iterator my_vector<T, Allocator, GrowthPolicy>::crbegin() const noexcept {
         return const_reverse_iterator(end());
     }
 
-    template <typename T>
-    typename my_vector<T>::reverse_iterator my_vector<T>::rend() noexcept {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::reverse_iterator my_vector<T, Allocator, GrowthPolicy>::rend() noexcept {
         return reverse_iterator(begin());
     }
 
-    template <typename T>
-    typename my_vector<T>::const_reverse_iterator my_vector<T>::rend() const noexcept {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::const_reverse_iterator my_vector<T, Allocator, GrowthPolicy>::rend() const noexcept {
         return const_reverse_iterator(begin());
     }
 
-    template <typename T>
-    typename my_vector<T>::const_reverse_iterator my_vector<T>::crend() const noexcept {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::const_reverse_iterator my_vector<T, Allocator, GrowthPolicy>::crend() const noexcept {
         return const_reverse_iterator(begin());
     }
 
     // Capacity implementations
-    template <typename T>
-    bool my_vector<T>::is_empty() const noexcept {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::allocator_type my_vector<T, Allocator, GrowthPolicy>::get_allocator() const noexcept {
+        return alloc_;
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr bool my_vector<T, Allocator, GrowthPolicy>::is_empty() const noexcept {
         return size_ == 0;
     }
 
-    template <typename T>
-    typename my_vector<T>::size_type my_vector<T>::size() const noexcept {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::size_type my_vector<T, Allocator, GrowthPolicy>::size() const noexcept {
         return size_;
     }
 
-    template <typename T>
-    typename my_vector<T>::size_type my_vector<T>::max_size() noexcept {
-        return std::numeric_limits<size_type>::max() / sizeof(T);
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::size_type my_vector<T, Allocator, GrowthPolicy>::max_size() const noexcept {
+        return std::min<size_type>(alloc_traits::max_size(alloc_), std::numeric_limits<size_type>::max() / sizeof(T));
     }
 
-    template <typename T>
-    void my_vector<T>::reserve(size_type new_cap) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::reserve(size_type new_cap) {
         if (new_cap > capacity_)
         {
             reallocate(new_cap);
         }
     }
 
-    template <typename T>
-    typename my_vector<T>::size_type my_vector<T>::capacity() const noexcept {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::size_type my_vector<T, Allocator, GrowthPolicy>::capacity() const noexcept {
         return capacity_;
     }
 
-    template <typename T>
-    void my_vector<T>::shrink_to_fit() {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::shrink_to_fit() {
         if (size_ < capacity_)
         {
             reallocate(size_);
@@ -421,95 +655,64 @@ namespace myVector
     }
 
     // Modifier implementations
-    template <typename T>
-    void my_vector<T>::clear() noexcept {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::clear() noexcept {
         destroy_range(data_, data_ + size_);
         size_ = 0;
     }
 
-    template <typename T>
-    typename my_vector<T>::iterator my_vector<T>::insert(const_iterator pos, const T& value) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::iterator my_vector<T, Allocator, GrowthPolicy>::insert(const_iterator pos, const T& value) {
+        MY_VECTOR_ASSERT(pos.stamp_.valid());
         size_type index = pos.ptr_ - data_;
 
         if (size_ == capacity_)
         {
             size_type new_capacity = calculate_growth(size_ + 1);
-            reallocate_insert(index, value, new_capacity);
+            reallocate_insert(index, 1, new_capacity, [&](pointer gap) { construct(gap, value); });
         } else {
+            // value may live in the part that is about to move
+            T value_copy(value);
             shift_right(index, 1);
             try
-            {
-                T value_copy(value);
-                new (data_ + index) T(std::move(value_copy));
-            } catch (...)
+            { construct(data_ + index, std::move(value_copy)); } catch (...)
             {
                 shift_left(index + 1, 1);
                 throw;
             }
-            ++size_;
         }
 
-        return iterator(data_ + index);
+        return make_iterator(data_ + index);
     }
 
-    template <typename T>
-    typename my_vector<T>::iterator my_vector<T>::insert(const_iterator pos, T&& value) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::iterator my_vector<T, Allocator, GrowthPolicy>::insert(const_iterator pos, T&& value) {
+        MY_VECTOR_ASSERT(pos.stamp_.valid());
         size_type index = pos.ptr_ - data_;
 
         if (size_ == capacity_)
         {
             size_type new_capacity = calculate_growth(size_ + 1);
-            pointer   new_data = allocate(new_capacity);
-            size_type new_size = 0;
-
-            try
-            {
-                for (size_type i = 0; i < index; ++i)
-                {
-                    new (new_data + new_size) T(std::move(data_[i]));
-                    ++new_size;
-                }
-
-                new (new_data + new_size) T(std::move(value));
-                ++new_size;
-
-                for (size_type i = index; i < size_; ++i)
-                {
-                    new (new_data + new_size) T(std::move(data_[i]));
-                    ++new_size;
-                }
-            } catch (...)
-            {
-                destroy_range(new_data, new_data + new_size);
-                deallocate(new_data, new_capacity);
-                throw;
-            }
-
-            destroy_range(data_, data_ + size_);
-            deallocate();
-
-            data_ = new_data;
-            size_ = new_size;
-            capacity_ = new_capacity;
+            reallocate_insert(index, 1, new_capacity, [&](pointer gap) { construct(gap, std::move(value)); });
         } else {
             shift_right(index, 1);
             try
-            { new (data_ + index) T(std::move(value)); } catch (...)
+            { construct(data_ + index, std::move(value)); } catch (...)
             {
                 shift_left(index + 1, 1);
                 throw;
             }
-            ++size_;
         }
 
-        return iterator(data_ + index);
+        return make_iterator(data_ + index);
     }
 
-    template <typename T>
-    typename my_vector<T>::iterator my_vector<T>::insert(const_iterator pos, size_type n, const T& value) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::iterator my_vector<T, Allocator, GrowthPolicy>::insert(const_iterator pos, size_type n, const T& value) {
+        MY_VECTOR_ASSERT(pos.stamp_.valid());
         if (n == 0)
         {
-            return iterator(const_cast<pointer>(pos.ptr_));
+            return iterator(const_cast<pointer>(pos.ptr_), pos.stamp_);
         }
 
         size_type index = pos.ptr_ - data_;
@@ -517,228 +720,142 @@ namespace myVector
         if (size_ + n > capacity_)
         {
             size_type new_capacity = calculate_growth(size_ + n);
-            pointer   new_data = allocate(new_capacity);
-            size_type new_size = 0;
-
-            try
-            {
-                for (size_type i = 0; i < index; ++i)
-                {
-                    new (new_data + new_size) T(std::move(data_[i]));
-                    ++new_size;
-                }
-
-                for (size_type i = 0; i < n; ++i)
+            reallocate_insert(index, n, new_capacity, [&](pointer gap) {
+                size_type constructed = 0;
+                try
                 {
-                    new (new_data + new_size) T(value);
-                    ++new_size;
-                }
-
-                for (size_type i = index; i < size_; ++i)
+                    for (; constructed < n; ++constructed)
+                    {
+                        construct(gap + constructed, value);
+                    }
+                } catch (...)
                 {
-                    new (new_data + new_size) T(std::move(data_[i]));
-                    ++new_size;
+                    destroy_range(gap, gap + constructed);
+                    throw;
                 }
-            } catch (...)
-            {
-                destroy_range(new_data, new_data + new_size);
-                deallocate(new_data, new_capacity);
-                throw;
-            }
-
-            destroy_range(data_, data_ + size_);
-            deallocate();
-
-            data_ = new_data;
-            size_ = new_size;
-            capacity_ = new_capacity;
+            });
         } else {
+            T value_copy(value);
             shift_right(index, n);
             try
             {
-                for (size_type i = 0; i < n; ++i)
-                {
-                    new (data_ + index + i) T(value);
-                }
+                construct_n(data_ + index, n, value_copy);
             } catch (...)
             {
-                size_type constructed = 0;
-                while (constructed < n && data_ + index + constructed != nullptr)
-                {
-                    ++constructed;
-                }
-                destroy_range(data_ + index, data_ + index + constructed);
                 shift_left(index + n, n);
                 throw;
             }
-            size_ += n;
         }
 
-        return iterator(data_ + index);
+        return make_iterator(data_ + index);
     }
 
-    template <typename T>
+    template <typename T, typename Allocator, typename GrowthPolicy>
     template <typename InputIt, typename>
-    typename my_vector<T>::iterator my_vector<T>::insert(const_iterator pos, InputIt first, InputIt last) {
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::iterator my_vector<T, Allocator, GrowthPolicy>::insert(const_iterator pos, InputIt first, InputIt last) {
+        MY_VECTOR_ASSERT(pos.stamp_.valid());
         if (first == last)
         {
-            return iterator(const_cast<pointer>(pos.ptr_));
+            return iterator(const_cast<pointer>(pos.ptr_), pos.stamp_);
         }
 
         size_type index = pos.ptr_ - data_;
-        my_vector tmp(first, last);
-        size_type numElements = tmp.size();
 
-        if (size_ + numElements > capacity_)
+        if constexpr (is_forward_iterator<InputIt>)
         {
-            size_type new_capacity = calculate_growth(size_ + numElements);
-            pointer   new_data = allocate(new_capacity);
-            size_type new_size = 0;
+            size_type numElements = std::distance(first, last);
 
-            try
+            if (numElements > capacity_ - size_)
             {
-                for (size_type i = 0; i < index; ++i)
-                {
-                    new (new_data + new_size) T(std::move(data_[i]));
-                    ++new_size;
-                }
-
-                for (size_type i = 0; i < numElements; ++i)
+                size_type new_capacity = calculate_growth(size_ + numElements);
+                reallocate_insert(index, numElements, new_capacity,
+                                  [&](pointer gap) { construct_copy(gap, first, numElements); });
+            } else {
+                shift_right(index, numElements);
+                try
                 {
-                    new (new_data + new_size) T(std::move(tmp.data_[i]));
-                    ++new_size;
-                }
-
-                for (size_type i = index; i < size_; ++i)
+                    construct_copy(data_ + index, first, numElements);
+                } catch (...)
                 {
-                    new (new_data + new_size) T(std::move(data_[i]));
-                    ++new_size;
+                    shift_left(index + numElements, numElements);
+                    throw;
                 }
-            } catch (...)
-            {
-                destroy_range(new_data, new_data + new_size);
-                deallocate(new_data, new_capacity);
-                throw;
             }
-
-            destroy_range(data_, data_ + size_);
-            deallocate();
-
-            data_ = new_data;
-            size_ = new_size;
-            capacity_ = new_capacity;
         } else {
-            shift_right(index, numElements);
-            try
-            {
-                for (size_type i = 0; i < numElements; ++i)
-                {
-                    new (data_ + index + i) T(std::move(tmp.data_[i]));
-                }
-            } catch (...)
-            {
-                size_type constructed = 0;
-                while (constructed < numElements && data_ + index + constructed != nullptr)
-                {
-                    ++constructed;
-                }
-                destroy_range(data_ + index, data_ + index + constructed);
-                shift_left(index + numElements, numElements);
-                throw;
-            }
-            size_ += numElements;
+            // can't count a single-pass range: append it, then rotate the new tail into place
+            size_type old_size = size_;
+            append(first, last);
+            std::rotate(data_ + index, data_ + old_size, data_ + size_);
         }
 
-        return iterator(data_ + index);
+        return make_iterator(data_ + index);
     }
 
-    template <typename T>
-    typename my_vector<T>::iterator my_vector<T>::insert(const_iterator pos, std::initializer_list<T> ilist) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::iterator my_vector<T, Allocator, GrowthPolicy>::insert(const_iterator pos, std::initializer_list<T> ilist) {
         return insert(pos, ilist.begin(), ilist.end());
     }
 
-    template <typename T>
-    typename my_vector<T>::iterator my_vector<T>::erase(const_iterator pos) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::iterator my_vector<T, Allocator, GrowthPolicy>::erase(const_iterator pos) {
         return erase(pos, pos + 1);
     }
 
-    template <typename T>
-    typename my_vector<T>::iterator my_vector<T>::erase(const_iterator first, const_iterator last) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::iterator my_vector<T, Allocator, GrowthPolicy>::erase(const_iterator first, const_iterator last) {
+        MY_VECTOR_ASSERT(first.stamp_.valid() && last.stamp_.valid());
         size_type index_first = first.ptr_ - data_;
         size_type index_last = last.ptr_ - data_;
         size_type count = index_last - index_first;
 
         if (count == 0)
         {
-            return iterator(data_ + index_first);
+            return make_iterator(data_ + index_first);
         }
 
-        destroy_range(data_ + index_first, data_ + index_last);
-
-        for (size_type i = index_last; i < size_; ++i)
+        if constexpr (is_trivially_relocatable_v<T>)
         {
-            try
-            { new (data_ + i - count) T(std::move(data_[i])); } catch (...)
-            {
-                size_ = i - count;
-                throw;
-            }
-            data_[i].~T();
+            destroy_range(data_ + index_first, data_ + index_last);
+            shift_left(index_last, count);
+        } else {
+            std::move(data_ + index_last, data_ + size_, data_ + index_first);
+            destroy_range(data_ + size_ - count, data_ + size_);
+            size_ -= count;
         }
 
-        size_ -= count;
-        return iterator(data_ + index_first);
+        return make_iterator(data_ + index_first);
     }
 
-    template <typename T>
-    void my_vector<T>::push_back(const T& value) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::push_back(const T& value) {
         T value_copy(value);
         emplace_back(std::move(value_copy));
     }
 
-    template <typename T>
-    void my_vector<T>::push_back(T&& value) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::push_back(T&& value) {
         emplace_back(std::move(value));
     }
 
-    template <typename T>
+    template <typename T, typename Allocator, typename GrowthPolicy>
     template <typename... Args>
-    typename my_vector<T>::reference my_vector<T>::emplace_back(Args&&... args) {
+    constexpr typename my_vector<T, Allocator, GrowthPolicy>::reference my_vector<T, Allocator, GrowthPolicy>::emplace_back(Args&&... args) {
         if (size_ == capacity_)
         {
             size_type new_capacity = calculate_growth(size_ + 1);
-            pointer   new_data = allocate(new_capacity);
-            size_type new_size = 0;
-
-            try
+            if constexpr (grows_in_place)
             {
-                new (new_data + size_) T(std::forward<Args>(args)...);
-                for (size_type i = 0; i < size_; ++i)
-                {
-                    new (new_data + i) T(std::move(data_[i]));
-                    ++new_size;
-                }
-                ++new_size;
-            } catch (...)
-            {
-                if (new_data + size_ != nullptr)
-                {
-                    (new_data + size_)->~T();
-                }
-                destroy_range(new_data, new_data + new_size);
-                deallocate(new_data, new_capacity);
-                throw;
+                // args may refer to an element of the block that is about to move
+                T value(std::forward<Args>(args)...);
+                reallocate(new_capacity);
+                construct(data_ + size_, std::move(value));
+                ++size_;
+            } else {
+                reallocate_insert(size_, 1, new_capacity, [&](pointer gap) { construct(gap, std::forward<Args>(args)...); });
             }
-
-            destroy_range(data_, data_ + size_);
-            deallocate();
-
-            data_ = new_data;
-            size_ = new_size;
-            capacity_ = new_capacity;
         } else {
             try
-            { new (data_ + size_) T(std::forward<Args>(args)...); } catch (...)
+            { construct(data_ + size_, std::forward<Args>(args)...); } catch (...)
             { throw; }
             ++size_;
         }
@@ -746,22 +863,23 @@ namespace myVector
         return back();
     }
 
-    template <typename T>
-    void my_vector<T>::pop_back() {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::pop_back() {
+        MY_VECTOR_ASSERT(size_ > 0);
         if (size_ > 0)
         {
             --size_;
-            data_[size_].~T();
+            destroy(data_ + size_);
         }
     }
 
-    template <typename T>
-    void my_vector<T>::resize(size_type new_size) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::resize(size_type new_size) {
         resize(new_size, T());
     }
 
-    template <typename T>
-    void my_vector<T>::resize(size_type new_size, const T& value) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::resize(size_type new_size, const T& value) {
         if (new_size > size_)
         {
             if (new_size > capacity_)
@@ -773,11 +891,11 @@ namespace myVector
             for (size_type i = size_; i < new_size; ++i)
             {
                 try
-                { new (data_ + i) T(value); } catch (...)
+                { construct(data_ + i, value); } catch (...)
                 {
                     for (size_type j = size_; j < i; ++j)
                     {
-                        data_[j].~T();
+                        destroy(data_ + j);
                     }
                     throw;
                 }
@@ -786,14 +904,90 @@ namespace myVector
         } else if (new_size < size_) {
             for (size_type i = new_size; i < size_; ++i)
             {
-                data_[i].~T();
+                destroy(data_ + i);
             }
             size_ = new_size;
         }
     }
 
-    template <typename T>
-    void my_vector<T>::assign(size_type n, const T& value) {
+    // Like resize, but new elements are default-initialized: trivial types keep whatever bytes
+    // the buffer had, which saves zeroing memory that is about to be overwritten anyway
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::resize_default_init(size_type new_size) {
+        if (new_size > size_)
+        {
+            if (new_size > capacity_)
+            {
+                reallocate(calculate_growth(new_size));
+            }
+
+            if constexpr (std::is_trivially_default_constructible_v<T>)
+            {
+                if !consteval
+                {
+                    size_ = new_size;
+                    return;
+                }
+            }
+
+            size_type i = size_;
+            try
+            {
+                for (; i < new_size; ++i)
+                {
+                    // placement new isn't a constant expression, and constant evaluation can't
+                    // leave the new slots without objects either, so it value-initializes them
+                    if consteval
+                    {
+                        std::construct_at(data_ + i);
+                    } else {
+                        ::new (static_cast<void*>(data_ + i)) T;
+                    }
+                }
+            } catch (...)
+            {
+                destroy_range(data_ + size_, data_ + i);
+                throw;
+            }
+            size_ = new_size;
+        } else if (new_size < size_) {
+            destroy_range(data_ + new_size, data_ + size_);
+            size_ = new_size;
+        }
+    }
+
+    // Modeled on std::string::resize_and_overwrite: makes room for n elements and calls
+    // op(data(), n). op writes into the buffer (the tail past size() is uninitialized)
+    // and returns how many elements are valid now, which becomes the new size.
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    template <typename Operation>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::resize_and_overwrite(size_type n, Operation op) {
+        static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+                      "my_vector::resize_and_overwrite: T must be a trivial type");
+
+        if (n > capacity_)
+        {
+            reallocate(calculate_growth(n));
+        }
+        if consteval
+        {
+            // op may only write to live objects during constant evaluation
+            for (size_type i = size_; i < n; ++i)
+            {
+                std::construct_at(data_ + i);
+            }
+        }
+
+        const size_type produced = static_cast<size_type>(std::move(op)(data_, n));
+        if (produced > n)
+        {
+            throw std::length_error("my_vector::resize_and_overwrite: operation produced more than n elements");
+        }
+        size_ = produced;
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::assign(size_type n, const T& value) {
         clear();
 
         if (n > capacity_)
@@ -806,7 +1000,7 @@ namespace myVector
         for (size_type i = 0; i < n; ++i)
         {
             try
-            { new (data_ + i) T(value); } catch (...)
+            { construct(data_ + i, value); } catch (...)
             {
                 destroy_range(data_, data_ + i);
                 size_ = 0;
@@ -817,110 +1011,366 @@ namespace myVector
         size_ = n;
     }
 
-    template <typename T>
+    template <typename T, typename Allocator, typename GrowthPolicy>
     template <typename InputIt, typename>
-    void my_vector<T>::assign(InputIt first, InputIt last) {
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::assign(InputIt first, InputIt last) {
         clear();
 
-        size_type count = 0;
-        for (InputIt it = first; it != last; ++it)
+        if constexpr (is_forward_iterator<InputIt>)
+        {
+            size_type count = std::distance(first, last);
+
+            if (count > capacity_)
+            {
+                deallocate();
+                data_ = allocate(count);
+                capacity_ = count;
+            }
+
+            construct_copy(data_, first, count);
+            size_ = count;
+        } else {
+            append(first, last);
+        }
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::assign(std::initializer_list<T> ilist) {
+        assign(ilist.begin(), ilist.end());
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    template <execution_policy Policy>
+    void my_vector<T, Allocator, GrowthPolicy>::assign(Policy&&, size_type n, const T& value) {
+        assign_filled<Policy>(n, [&](pointer dest, size_type, size_type count) { construct_n(dest, count, value); });
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    template <execution_policy Policy, legacy_random_access_iterator RandomIt>
+    void my_vector<T, Allocator, GrowthPolicy>::assign(Policy&&, RandomIt first, RandomIt last) {
+        assign_filled<Policy>(static_cast<size_type>(last - first), [&](pointer dest, size_type offset, size_type count) {
+            construct_copy(dest, first + static_cast<difference_type>(offset), count);
+        });
+    }
+
+    // Replaces the contents with op(x) for every x in [first, last); op may run on several threads at once
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    template <execution_policy Policy, legacy_random_access_iterator RandomIt, typename UnaryOp>
+    void my_vector<T, Allocator, GrowthPolicy>::assign_transformed(Policy&&, RandomIt first, RandomIt last, UnaryOp op) {
+        assign_filled<Policy>(static_cast<size_type>(last - first), [&](pointer dest, size_type offset, size_type count) {
+            size_type constructed = 0;
+            try
+            {
+                for (; constructed < count; ++constructed)
+                {
+                    construct(dest + constructed, op(first[static_cast<difference_type>(offset + constructed)]));
+                }
+            } catch (...)
+            {
+                destroy_range(dest, dest + constructed);
+                throw;
+            }
+        });
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    template <execution_policy Policy>
+    void my_vector<T, Allocator, GrowthPolicy>::resize(Policy&&, size_type new_size, const T& value) {
+        if (new_size <= size_ || !parallel_worthwhile<Policy>((new_size - size_) * sizeof(T)))
         {
-            ++count;
+            resize(new_size, value);
+            return;
         }
 
-        if (count > capacity_)
+        if (new_size > capacity_)
         {
-            deallocate();
-            data_ = allocate(count);
-            capacity_ = count;
+            reallocate(calculate_growth(new_size));
         }
+        parallel_construct(data_ + size_, new_size - size_,
+                           [&](pointer dest, size_type, size_type count) { construct_n(dest, count, value); });
+        size_ = new_size;
+    }
 
-        size_type index = 0;
-        for (InputIt it = first; it != last; ++it, ++index)
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    template <std::ranges::input_range R>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::append_range(R&& range) {
+        if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>)
         {
-            try
-            { new (data_ + index) T(*it); } catch (...)
+            append_counted(std::ranges::begin(range), static_cast<size_type>(std::ranges::distance(range)));
+        } else {
+            for (auto&& element : range)
             {
-                destroy_range(data_, data_ + index);
-                size_ = 0;
-                throw;
+                emplace_back(std::forward<decltype(element)>(element));
             }
         }
+    }
 
-        size_ = count;
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    template <typename InputIt, typename>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::append(InputIt first, InputIt last) {
+        if constexpr (is_forward_iterator<InputIt>)
+        {
+            append_counted(first, static_cast<size_type>(std::distance(first, last)));
+        } else {
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        }
     }
 
-    template <typename T>
-    void my_vector<T>::assign(std::initializer_list<T> ilist) {
-        assign(ilist.begin(), ilist.end());
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::append_n(size_type n, const T& value) {
+        if (n == 0)
+        {
+            return;
+        }
+
+        if (size_ + n > capacity_)
+        {
+            // the gap is filled before the old elements move, so value may alias one of them
+            reallocate_insert(size_, n, calculate_growth(size_ + n), [&](pointer gap) { construct_n(gap, n, value); });
+        } else {
+            construct_n(data_ + size_, n, value);
+            size_ += n;
+        }
     }
 
-    template <typename T>
-    void my_vector<T>::swap(my_vector& other) noexcept {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::swap(my_vector& other) noexcept(
+        alloc_traits::propagate_on_container_swap::value || alloc_traits::is_always_equal::value) {
         using std::swap;
+        if constexpr (alloc_traits::propagate_on_container_swap::value)
+        {
+            swap(alloc_, other.alloc_);
+        }
         swap(data_, other.data_);
         swap(size_, other.size_);
         swap(capacity_, other.capacity_);
+        generation_.swap(other.generation_);
     }
 
-    // spaceship operator
-    template <typename T>
-    auto my_vector<T>::operator<=>(const my_vector& other) const {
-        if (size_ != other.size_)
+    // comparison operators
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr bool my_vector<T, Allocator, GrowthPolicy>::operator==(const my_vector& other) const {
+        if consteval
         {
-            return size_ <=> other.size_;
+            return size_ == other.size_ && std::equal(data_, data_ + size_, other.data_);
         }
+        return size_ == other.size_ && equal_elements(data_, other.data_, size_);
+    }
 
-        for (size_type i = 0; i < size_; ++i)
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr auto my_vector<T, Allocator, GrowthPolicy>::operator<=>(const my_vector& other) const {
+        using ordering = element_ordering_t<T>;
+        if (size_ != other.size_)
         {
-            if (auto cmp = data_[i] <=> other.data_[i]; cmp != 0)
-            {
-                return cmp;
-            }
+            return static_cast<ordering>(size_ <=> other.size_);
         }
-
-        return std::strong_ordering::equal;
+        if consteval
+        {
+            return static_cast<ordering>(std::lexicographical_compare_three_way(data_, data_ + size_, other.data_, other.data_ + size_));
+        }
+        return compare_elements(data_, other.data_, size_);
     }
 
     // Helper method implementations
-    template <typename T>
-    my_vector<T>::pointer my_vector<T>::allocate(size_type n) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr my_vector<T, Allocator, GrowthPolicy>::pointer my_vector<T, Allocator, GrowthPolicy>::allocate(size_type n) {
         if (n == 0)
         {
             return nullptr;
         }
 
-        return static_cast<pointer>(::operator new(n * sizeof(T)));
+        generation_.attach();
+        pointer ptr = alloc_traits::allocate(alloc_, n);
+        instrumentation::on_allocate(n, n * sizeof(T));
+        return ptr;
     }
 
-    template <typename T>
-    void my_vector<T>::deallocate() {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::deallocate() {
         if (data_)
         {
-            ::operator delete(data_);
+            deallocate(data_, capacity_);
+            generation_.invalidate();
             data_ = nullptr;
             capacity_ = 0;
         }
     }
 
-    template <typename T>
-    void my_vector<T>::deallocate(pointer ptr, size_type n) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::deallocate(pointer ptr, size_type n) {
         if (ptr)
         {
-            ::operator delete(ptr);
+            alloc_traits::deallocate(alloc_, ptr, n);
+            instrumentation::on_deallocate();
         }
     }
 
-    template <typename T>
-    void my_vector<T>::destroy_range(pointer first, pointer last) {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    template <typename... Args>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::construct(pointer ptr, Args&&... args) {
+        alloc_traits::construct(alloc_, ptr, std::forward<Args>(args)...);
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::destroy(pointer ptr) noexcept {
+        alloc_traits::destroy(alloc_, ptr);
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::destroy_range(pointer first, pointer last) noexcept {
         for (pointer ptr = first; ptr != last; ++ptr)
         {
-            ptr->~T();
+            destroy(ptr);
         }
     }
 
-    template <typename T>
-    void my_vector<T>::allocate_and_fill(size_type n, const T& value) {
+    // Takes over other's buffer, the allocators must already be interchangeable
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::steal(my_vector& other) noexcept {
+        data_ = other.data_;
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.capacity_ = 0;
+        // iterators follow the buffer
+        generation_.take(other.generation_);
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr auto my_vector<T, Allocator, GrowthPolicy>::make_iterator(pointer ptr) noexcept {
+        return iterator(ptr, generation_.stamp());
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr auto my_vector<T, Allocator, GrowthPolicy>::make_iterator(const_pointer ptr) const noexcept {
+        return const_iterator(ptr, generation_.stamp());
+    }
+
+    // Constructs n copies of value at dest; on failure destroys what it built and rethrows
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::construct_n(pointer dest, size_type n, const T& value) {
+        size_type constructed = 0;
+        try
+        {
+            for (; constructed < n; ++constructed)
+            {
+                construct(dest + constructed, value);
+            }
+        } catch (...)
+        {
+            destroy_range(dest, dest + constructed);
+            throw;
+        }
+    }
+
+    // Copies count elements starting at first to dest, a single memcpy when the source is
+    // contiguous storage of the same trivially copyable type (element by element in constant
+    // evaluation, which has no memcpy). Same cleanup contract as construct_n.
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    template <typename InputIt>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::construct_copy(pointer dest, InputIt first, size_type count) {
+        if constexpr (std::contiguous_iterator<InputIt> && std::is_trivially_copyable_v<T> &&
+                      std::is_same_v<std::iter_value_t<InputIt>, T>)
+        {
+            if !consteval
+            {
+                if (count > 0)
+                {
+                    detail::copy_bytes(static_cast<void*>(dest), static_cast<const void*>(std::to_address(first)), count * sizeof(T));
+                }
+                return;
+            }
+        }
+
+        size_type constructed = 0;
+        try
+        {
+            for (; constructed < count; ++constructed, ++first)
+            {
+                construct(dest + constructed, *first);
+            }
+        } catch (...)
+        {
+            destroy_range(dest, dest + constructed);
+            throw;
+        }
+    }
+
+    // Appends count elements read from first, growing at most once
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    template <typename InputIt>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::append_counted(InputIt first, size_type count) {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (size_ + count > capacity_)
+        {
+            // filled before relocation, so the source may be this vector's own elements
+            reallocate_insert(size_, count, calculate_growth(size_ + count),
+                              [&](pointer gap) { construct_copy(gap, first, count); });
+        } else {
+            construct_copy(data_ + size_, first, count);
+            size_ += count;
+        }
+    }
+
+    // fill(dest, offset, count) constructs elements [offset, offset + count) of the range at dest,
+    // with construct_n's cleanup contract. Runs the chunks on the thread pool; if any of them throws,
+    // the chunks that did finish are destroyed too and the first exception is rethrown.
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    template <typename Fill>
+    void my_vector<T, Allocator, GrowthPolicy>::parallel_construct(pointer dest, size_type n, Fill fill) {
+        const chunk_plan plan = plan_chunks(n, sizeof(T));
+        auto chunk_end = [&](std::size_t i) { return std::min(n, (i + 1) * plan.chunk); };
+
+        std::vector<std::exception_ptr> errors = thread_pool::instance().run(
+            plan.count, [&](std::size_t i) { fill(dest + i * plan.chunk, i * plan.chunk, chunk_end(i) - i * plan.chunk); });
+
+        auto failed = std::find_if(errors.begin(), errors.end(), [](const std::exception_ptr& e) { return e != nullptr; });
+        if (failed != errors.end())
+        {
+            for (std::size_t i = 0; i < plan.count; ++i)
+            {
+                if (!errors[i])
+                {
+                    destroy_range(dest + i * plan.chunk, dest + chunk_end(i));
+                }
+            }
+            std::rethrow_exception(*failed);
+        }
+    }
+
+    // assign's shape for a counted fill: clear, make room for n, then build in parallel when it pays off
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    template <execution_policy Policy, typename Fill>
+    void my_vector<T, Allocator, GrowthPolicy>::assign_filled(size_type n, Fill fill) {
+        clear();
+
+        if (n > capacity_)
+        {
+            deallocate();
+            data_ = allocate(n);
+            capacity_ = n;
+        }
+
+        if (parallel_worthwhile<Policy>(n * sizeof(T)))
+        {
+            parallel_construct(data_, n, fill);
+        } else {
+            fill(data_, 0, n);
+        }
+        size_ = n;
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::allocate_and_fill(size_type n, const T& value) {
         data_ = allocate(n);
         capacity_ = n;
 
@@ -928,7 +1378,7 @@ namespace myVector
         {
             for (size_type i = 0; i < n; ++i)
             {
-                new (data_ + i) T(value);
+                construct(data_ + i, value);
                 ++size_;
             }
         } catch (...)
@@ -940,9 +1390,9 @@ namespace myVector
         }
     }
 
-    template <typename T>
+    template <typename T, typename Allocator, typename GrowthPolicy>
     template <typename InputIt>
-    void my_vector<T>::allocate_and_copy(InputIt first, InputIt last) {
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::allocate_and_copy(InputIt first, InputIt last) {
         size_type count = std::distance(first, last);
 
         if (count > 0)
@@ -952,149 +1402,241 @@ namespace myVector
 
             try
             {
-                for (InputIt it = first; it != last; ++it, ++size_)
-                {
-                    new (data_ + size_) T(*it);
-                }
+                construct_copy(data_, first, count);
             } catch (...)
             {
-                destroy_range(data_, data_ + size_);
                 deallocate();
-                size_ = 0;
                 throw;
             }
+            size_ = count;
         }
     }
 
-    template <typename T>
-    void my_vector<T>::reallocate(size_type new_capacity) {
-        pointer   new_data = allocate(new_capacity);
-        size_type new_size = 0;
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::relocate_range(pointer first, pointer last, pointer dest) {
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            if !consteval
+            {
+                if (first != last)
+                {
+                    detail::copy_bytes(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(T));
+                }
+                return;
+            }
+        }
 
+        pointer current = dest;
         try
         {
-            for (size_type i = 0; i < size_; ++i)
+            for (; first != last; ++first, ++current)
             {
-                new (new_data + i) T(std::move(data_[i]));
-                ++new_size;
+                construct(current, std::move(*first));
             }
         } catch (...)
         {
-            destroy_range(new_data, new_data + new_size);
-            deallocate(new_data, new_capacity);
+            destroy_range(dest, current);
             throw;
         }
-
-        destroy_range(data_, data_ + size_);
-        deallocate();
-
-        data_ = new_data;
-        size_ = new_size;
-        capacity_ = new_capacity;
     }
 
-    template <typename T>
-    void my_vector<T>::reallocate_insert(size_type index, const T& value, size_type new_capacity) {
-        pointer   new_data = allocate(new_capacity);
-        size_type new_size = 0;
+    // Ends the lifetime of relocated-from objects. Bitwise-relocated ones now live in the
+    // new buffer, so running their destructors here would be a double destroy.
+    // Constant evaluation relocates by move + destroy for every type.
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::finish_relocation(pointer first, pointer last) noexcept {
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            if !consteval
+            {
+                return;
+            }
+        }
+        destroy_range(first, last);
+    }
 
-        try
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::reallocate(size_type new_capacity) {
+        // shrink_to_fit of an empty vector: no storage at all rather than a zero-size block
+        if (new_capacity == 0)
+        {
+            deallocate();
+            return;
+        }
+        if constexpr (grows_in_place)
         {
-            for (size_type i = 0; i < index; ++i)
+            if !consteval
             {
-                new (new_data + new_size) T(std::move(data_[i]));
-                ++new_size;
+                if (data_ != nullptr)
+                {
+                    data_ = alloc_.reallocate(data_, capacity_, new_capacity);
+                    capacity_ = new_capacity;
+                    generation_.invalidate();
+                    instrumentation::on_reallocate(new_capacity, 0);
+                    return;
+                }
             }
+        }
+        reallocate_insert(size_, 0, new_capacity, [](pointer) {});
+    }
 
-            new (new_data + new_size) T(value);
-            ++new_size;
+    // Moves the buffer into new_capacity storage leaving a hole of `count` slots at `index`,
+    // which `fill` must construct (and clean up after itself if it throws).
+    // The hole is filled first, so `fill` may still read the old elements.
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    template <typename Fill>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::reallocate_insert(size_type index, size_type count, size_type new_capacity, Fill&& fill) {
+        // new_capacity > 0 (reallocate() frees instead), so this never takes allocate()'s empty path
+        generation_.attach();
+        pointer new_data = alloc_traits::allocate(alloc_, new_capacity);
+        instrumentation::on_allocate(new_capacity, new_capacity * sizeof(T));
+
+        try
+        {
+            fill(new_data + index);
+        } catch (...)
+        {
+            deallocate(new_data, new_capacity);
+            throw;
+        }
 
-            for (size_type i = index; i < size_; ++i)
+        try
+        {
+            relocate_range(data_, data_ + index, new_data);
+            try
+            {
+                relocate_range(data_ + index, data_ + size_, new_data + index + count);
+            } catch (...)
             {
-                new (new_data + new_size) T(std::move(data_[i]));
-                ++new_size;
+                destroy_range(new_data, new_data + index);
+                throw;
             }
         } catch (...)
         {
-            destroy_range(new_data, new_data + new_size);
+            destroy_range(new_data + index, new_data + index + count);
             deallocate(new_data, new_capacity);
             throw;
         }
 
-        destroy_range(data_, data_ + size_);
+        finish_relocation(data_, data_ + size_);
+        if (data_ != nullptr)
+        {
+            instrumentation::on_reallocate(new_capacity, size_);
+        }
         deallocate();
 
         data_ = new_data;
-        size_ = new_size;
+        size_ += count;
         capacity_ = new_capacity;
     }
 
-    template <typename T>
-    void my_vector<T>::shift_right(size_type index, size_type count) {
-        if (size_ + count > capacity_)
+    // Opens count raw slots at index by moving [index, size_) up, and grows size_ by count.
+    // The caller constructs the gap or closes it again with shift_left(index + count, count).
+    // Trivially relocatable types move with one memmove; others (and everything during constant
+    // evaluation) are move-constructed into the raw tail and move-assigned over live elements.
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::shift_right(size_type index, size_type count) {
+        if (count > capacity_ - size_)
         {
             throw std::length_error("my_vector::shift_right: capacity exceeded");
         }
 
-        for (size_type i = size_; i > index; --i)
+        pointer gap = data_ + index;
+        pointer end = data_ + size_;
+        size_type tail = size_ - index;
+
+        if constexpr (is_trivially_relocatable_v<T>)
         {
-            try
-            { new (data_ + i + count - 1) T(std::move(data_[i - 1])); } catch (...)
+            if !consteval
             {
-                for (size_type j = size_; j > i; --j)
+                if (tail > 0)
                 {
-                    (data_ + j + count - 1)->~T();
+                    std::memmove(static_cast<void*>(gap + count), static_cast<const void*>(gap), tail * sizeof(T));
                 }
-                throw;
+                size_ += count;
+                return;
             }
-            data_[i - 1].~T();
         }
-    }
 
-    template <typename T>
-    void my_vector<T>::shift_left(size_type index, size_type count) {
-        for (size_type i = index; i < size_; ++i)
+        // the last `spill` elements land past the end, the rest on slots that are still alive
+        size_type spill = std::min(count, tail);
+        size_type constructed = 0;
+        try
         {
-            data_[i - count].~T();
-            try
-            { new (data_ + i - count) T(std::move(data_[i])); } catch (...)
+            for (; constructed < spill; ++constructed)
             {
-                // Leave the vector in a consistent state
-                size_ = i - count;
-                throw;
+                construct(end + count - spill + constructed, std::move(*(end - spill + constructed)));
             }
-            data_[i].~T();
+            std::move_backward(gap, end - spill, end - spill + count);
+        } catch (...)
+        {
+            destroy_range(end + count - spill, end + count - spill + constructed);
+            throw;
         }
+        destroy_range(gap, gap + spill);
+
+        size_ += count;
     }
 
-    template <typename T>
-    my_vector<T>::size_type my_vector<T>::calculate_growth(size_type new_size) const {
-        const size_type max_sz = max_size();
+    // Closes the raw slots [index - count, index) by moving [index, size_) down, and shrinks size_ by count.
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void my_vector<T, Allocator, GrowthPolicy>::shift_left(size_type index, size_type count) {
+        pointer gap = data_ + index - count;
+        pointer end = data_ + size_;
+        size_type tail = size_ - index;
 
-        if (new_size > max_sz)
+        if constexpr (is_trivially_relocatable_v<T>)
         {
-            throw std::length_error("my_vector::calculate_growth: maximum size exceeded");
+            if !consteval
+            {
+                if (tail > 0)
+                {
+                    std::memmove(static_cast<void*>(gap), static_cast<const void*>(gap + count), tail * sizeof(T));
+                }
+                size_ -= count;
+                return;
+            }
         }
 
-        if (capacity_ == 0)
+        // construct into the raw slots, assign over the rest, drop the moved-from end
+        size_type fill = std::min(count, tail);
+        size_type constructed = 0;
+        try
+        {
+            for (; constructed < fill; ++constructed)
+            {
+                construct(gap + constructed, std::move(gap[count + constructed]));
+            }
+        } catch (...)
         {
-            return std::max<size_type>(1, new_size);
+            // keep the prefix and what was moved so far, drop everything after the gap
+            destroy_range(data_ + index, end);
+            size_ = index - count + constructed;
+            throw;
         }
+        std::move(gap + count + fill, end, gap + fill);
+        destroy_range(end - fill, end);
 
-        // TODO: Magic number? -- replace?
-        size_type new_capacity = capacity_ + (capacity_ / 2);
+        size_ -= count;
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr my_vector<T, Allocator, GrowthPolicy>::size_type my_vector<T, Allocator, GrowthPolicy>::calculate_growth(size_type new_size) const {
+        const size_type max_sz = max_size();
 
-        if (new_capacity < capacity_)
+        if (new_size > max_sz)
         {
-            new_capacity = max_sz;
+            throw std::length_error("my_vector::calculate_growth: maximum size exceeded");
         }
 
-        return std::max(new_capacity, new_size);
+        size_type new_capacity = GrowthPolicy::template next_capacity<T>(capacity_, new_size);
+
+        return std::clamp(new_capacity, new_size, max_sz);
     }
 
     // Non-member functions
-    template <typename T>
-    void swap(my_vector<T>& lhs, my_vector<T>& rhs) noexcept {
+    template <typename T, typename Allocator, typename GrowthPolicy>
+    constexpr void swap(my_vector<T, Allocator, GrowthPolicy>& lhs, my_vector<T, Allocator, GrowthPolicy>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
         lhs.swap(rhs);
     }
 
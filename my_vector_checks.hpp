@@ -0,0 +1,212 @@
+#ifndef MY_VECTOR_CHECKS_H
+#define MY_VECTOR_CHECKS_H
+
+// Opt-in hardening for my_vector, along the lines of _GLIBCXX_ASSERTIONS. Build with
+// MY_VECTOR_ASSERTIONS=1 (the same value in every translation unit, it changes the layout of
+// my_vector and its iterators, so it is never switched on implicitly) and operator[], front(),
+// back() and pop_back() check their preconditions, and iterators check that the buffer they
+// point into has not been reallocated or freed since. A failed check prints where and aborts.
+// With the macro at 0 the checks expand to nothing and an iterator is a bare pointer.
+
+#ifndef MY_VECTOR_ASSERTIONS
+#define MY_VECTOR_ASSERTIONS 0
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
+#if MY_VECTOR_ASSERTIONS
+// Calling the non-constexpr handler also makes a failed check a compile error in constant evaluation
+#define MY_VECTOR_ASSERT(condition)                                                                                    \
+    (__builtin_expect(static_cast<bool>(condition), 1)                                                                 \
+         ? void(0)                                                                                                     \
+         : ::myVector::detail::assertion_failed(__FILE__, __LINE__, __func__, #condition))
+#else
+#define MY_VECTOR_ASSERT(condition) void(0)
+#endif
+
+namespace myVector
+{
+    namespace detail
+    {
+        [[noreturn]] inline void assertion_failed(const char* file, int line, const char* function, const char* condition) noexcept {
+            std::fprintf(stderr, "%s:%d: %s: my_vector assertion '%s' failed.\n", file, line, function, condition);
+            std::abort();
+        }
+    } // namespace detail
+
+#if MY_VECTOR_ASSERTIONS
+    // Where the current generation of one vector's buffer is kept. Slots are pooled and never freed,
+    // so an iterator can still read its slot after the vector is gone.
+    struct generation_slot
+    {
+        std::atomic<std::uint64_t> generation{0};
+        generation_slot*           next_free = nullptr;
+    };
+
+    class generation_pool
+    {
+      public:
+        static generation_slot* acquire() {
+            std::lock_guard<std::mutex> lock(mutex());
+            generation_slot*&           head = free_list();
+            if (!head)
+            {
+                constexpr std::size_t block_size = 64;
+                generation_slot*      block = new generation_slot[block_size];
+                for (std::size_t i = 0; i + 1 < block_size; ++i)
+                {
+                    block[i].next_free = &block[i + 1];
+                }
+                head = block;
+            }
+            generation_slot* slot = head;
+            head = slot->next_free;
+            slot->generation.store(next_generation(), std::memory_order_relaxed);
+            return slot;
+        }
+
+        // Stales every iterator still stamped with the slot before handing it out again
+        static void release(generation_slot* slot) noexcept {
+            slot->generation.store(next_generation(), std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(mutex());
+            slot->next_free = free_list();
+            free_list() = slot;
+        }
+
+        // Generations are unique across all slots, so a recycled slot never matches an old stamp
+        static std::uint64_t next_generation() noexcept {
+            static std::atomic<std::uint64_t> counter{0};
+            return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+      private:
+        static std::mutex& mutex() {
+            static std::mutex* m = new std::mutex();
+            return *m;
+        }
+
+        static generation_slot*& free_list() {
+            static generation_slot* head = nullptr;
+            return head;
+        }
+    };
+
+    // What an iterator remembers of the buffer it was made from. Iterators made during constant
+    // evaluation, or not by my_vector, carry no slot and are not checked.
+    class iterator_stamp
+    {
+      public:
+        constexpr iterator_stamp() = default;
+        constexpr iterator_stamp(const generation_slot* slot, std::uint64_t generation) :
+            slot_(slot), generation_(generation) {}
+
+        constexpr bool valid() const noexcept {
+            if !consteval
+            {
+                return slot_ == nullptr || slot_->generation.load(std::memory_order_relaxed) == generation_;
+            }
+            return true;
+        }
+
+      private:
+        const generation_slot* slot_ = nullptr;
+        std::uint64_t          generation_ = 0;
+    };
+
+    // my_vector's side: a slot per vector, taken with its first buffer, moving along with the
+    // buffer on move and swap, and advanced whenever the buffer is reallocated or freed
+    class buffer_generation
+    {
+      public:
+        constexpr buffer_generation() = default;
+        // a copy has a buffer of its own
+        constexpr buffer_generation(const buffer_generation&) noexcept {}
+        constexpr buffer_generation& operator=(const buffer_generation&) noexcept { return *this; }
+
+        constexpr ~buffer_generation() {
+            if !consteval
+            {
+                if (slot_)
+                {
+                    generation_pool::release(slot_);
+                }
+            }
+        }
+
+        constexpr iterator_stamp stamp() const noexcept {
+            if !consteval
+            {
+                if (slot_)
+                {
+                    return iterator_stamp(slot_, slot_->generation.load(std::memory_order_relaxed));
+                }
+            }
+            return {};
+        }
+
+        // Takes the slot before the vector builds its first buffer, the only step that can throw
+        constexpr void attach() {
+            if !consteval
+            {
+                if (!slot_)
+                {
+                    slot_ = generation_pool::acquire();
+                }
+            }
+        }
+
+        // The buffer changed: iterators handed out so far are stale
+        constexpr void invalidate() noexcept {
+            if !consteval
+            {
+                if (slot_)
+                {
+                    slot_->generation.store(generation_pool::next_generation(), std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Iterators into other's buffer now belong to us
+        constexpr void take(buffer_generation& other) noexcept {
+            if !consteval
+            {
+                if (slot_)
+                {
+                    generation_pool::release(slot_);
+                }
+                slot_ = other.slot_;
+                other.slot_ = nullptr;
+            }
+        }
+
+        constexpr void swap(buffer_generation& other) noexcept {
+            generation_slot* tmp = slot_;
+            slot_ = other.slot_;
+            other.slot_ = tmp;
+        }
+
+      private:
+        generation_slot* slot_ = nullptr;
+    };
+#else
+    struct iterator_stamp
+    {
+        constexpr bool valid() const noexcept { return true; }
+    };
+
+    struct buffer_generation
+    {
+        constexpr iterator_stamp stamp() const noexcept { return {}; }
+        constexpr void           attach() noexcept {}
+        constexpr void           invalidate() noexcept {}
+        constexpr void           take(buffer_generation&) noexcept {}
+        constexpr void           swap(buffer_generation&) noexcept {}
+    };
+#endif
+}; // namespace myVector
+
+#endif // MY_VECTOR_CHECKS_H
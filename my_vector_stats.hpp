@@ -0,0 +1,248 @@
+#ifndef MY_VECTOR_STATS_H
+#define MY_VECTOR_STATS_H
+
+// Opt-in allocation tracking for my_vector. Build with MY_VECTOR_INSTRUMENTATION=1 (the same
+// value in every translation unit) and each my_vector instantiation records its allocations,
+// reallocations, relocated elements, peak capacity and the capacity left unused at destruction
+// in stats_registry. With the macro at 0 the hooks are empty inline functions and compile away.
+
+#ifndef MY_VECTOR_INSTRUMENTATION
+#define MY_VECTOR_INSTRUMENTATION 0
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+
+#if defined(__GNUG__)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+namespace myVector
+{
+    // Counters of one my_vector instantiation, as a plain copy
+    struct vector_stats
+    {
+        std::size_t allocations = 0;
+        std::size_t deallocations = 0;
+        std::size_t bytes_allocated = 0;
+        std::size_t reallocations = 0;
+        std::size_t elements_moved = 0;
+        std::size_t peak_capacity = 0;
+        std::size_t wasted_capacity = 0; // summed over destroyed vectors, in elements
+    };
+
+    class stats_registry
+    {
+      public:
+        struct counters
+        {
+            std::atomic<std::size_t> allocations{0};
+            std::atomic<std::size_t> deallocations{0};
+            std::atomic<std::size_t> bytes_allocated{0};
+            std::atomic<std::size_t> reallocations{0};
+            std::atomic<std::size_t> elements_moved{0};
+            std::atomic<std::size_t> peak_capacity{0};
+            std::atomic<std::size_t> wasted_capacity{0};
+
+            [[nodiscard]] vector_stats snapshot() const noexcept;
+            void reset() noexcept;
+            void raise_peak(std::size_t capacity) noexcept;
+        };
+
+        // Never destroyed, so vectors with static storage can still report from their destructors
+        static stats_registry& instance();
+
+        counters& add(const std::string& name);
+
+        [[nodiscard]] std::map<std::string, vector_stats> snapshot() const;
+        [[nodiscard]] vector_stats find(const std::string& name) const;
+        void reset();
+        void dump(std::ostream& out) const;
+
+      private:
+        stats_registry() = default;
+
+        mutable std::mutex mutex_;
+        std::map<std::string, std::unique_ptr<counters>> entries_;
+    };
+
+    // Readable name of a type, demangled where the ABI allows it
+    template <typename T>
+    std::string type_name() {
+#if defined(__GNUG__)
+        int status = 0;
+        std::unique_ptr<char, void (*)(void*)> demangled(abi::__cxa_demangle(typeid(T).name(), nullptr, nullptr, &status),
+                                                         std::free);
+        if (status == 0 && demangled)
+        {
+            return demangled.get();
+        }
+#endif
+        return typeid(T).name();
+    }
+
+    // The hooks my_vector calls; one set of counters per Vector type
+    template <typename Vector>
+    struct vector_instrumentation
+    {
+#if MY_VECTOR_INSTRUMENTATION
+        // Null if registering this instantiation ran out of memory; its events then go uncounted
+        // rather than escaping the noexcept hooks below
+        static stats_registry::counters* counters() noexcept {
+            static stats_registry::counters* entry = []() noexcept -> stats_registry::counters* {
+                try
+                {
+                    return &stats_registry::instance().add(type_name<Vector>());
+                } catch (...)
+                {
+                    return nullptr;
+                }
+            }();
+            return entry;
+        }
+
+        // Constant evaluation (a constexpr my_vector) has no registry to report to
+        static constexpr void on_allocate(std::size_t capacity, std::size_t bytes) noexcept {
+            if !consteval
+            {
+                if (auto* c = counters())
+                {
+                    c->allocations.fetch_add(1, std::memory_order_relaxed);
+                    c->bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+                    c->raise_peak(capacity);
+                }
+            }
+        }
+
+        static constexpr void on_deallocate() noexcept {
+            if !consteval
+            {
+                if (auto* c = counters())
+                {
+                    c->deallocations.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        static constexpr void on_reallocate(std::size_t capacity, std::size_t moved) noexcept {
+            if !consteval
+            {
+                if (auto* c = counters())
+                {
+                    c->reallocations.fetch_add(1, std::memory_order_relaxed);
+                    c->elements_moved.fetch_add(moved, std::memory_order_relaxed);
+                    c->raise_peak(capacity);
+                }
+            }
+        }
+
+        static constexpr void on_destroy(std::size_t unused) noexcept {
+            if !consteval
+            {
+                if (auto* c = counters())
+                {
+                    c->wasted_capacity.fetch_add(unused, std::memory_order_relaxed);
+                }
+            }
+        }
+#else
+        static constexpr void on_allocate(std::size_t, std::size_t) noexcept {}
+        static constexpr void on_deallocate() noexcept {}
+        static constexpr void on_reallocate(std::size_t, std::size_t) noexcept {}
+        static constexpr void on_destroy(std::size_t) noexcept {}
+#endif
+    };
+
+    // Stats of one instantiation, e.g. stats_of<my_vector<int>>()
+    template <typename Vector>
+    vector_stats stats_of() {
+        return stats_registry::instance().find(type_name<Vector>());
+    }
+
+    inline vector_stats stats_registry::counters::snapshot() const noexcept {
+        vector_stats s;
+        s.allocations = allocations.load(std::memory_order_relaxed);
+        s.deallocations = deallocations.load(std::memory_order_relaxed);
+        s.bytes_allocated = bytes_allocated.load(std::memory_order_relaxed);
+        s.reallocations = reallocations.load(std::memory_order_relaxed);
+        s.elements_moved = elements_moved.load(std::memory_order_relaxed);
+        s.peak_capacity = peak_capacity.load(std::memory_order_relaxed);
+        s.wasted_capacity = wasted_capacity.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    inline void stats_registry::counters::reset() noexcept {
+        allocations = 0;
+        deallocations = 0;
+        bytes_allocated = 0;
+        reallocations = 0;
+        elements_moved = 0;
+        peak_capacity = 0;
+        wasted_capacity = 0;
+    }
+
+    inline void stats_registry::counters::raise_peak(std::size_t capacity) noexcept {
+        std::size_t peak = peak_capacity.load(std::memory_order_relaxed);
+        while (capacity > peak && !peak_capacity.compare_exchange_weak(peak, capacity, std::memory_order_relaxed))
+        {}
+    }
+
+    inline stats_registry& stats_registry::instance() {
+        static stats_registry* registry = new stats_registry();
+        return *registry;
+    }
+
+    inline stats_registry::counters& stats_registry::add(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& entry = entries_[name];
+        if (!entry)
+        {
+            entry = std::make_unique<counters>();
+        }
+        return *entry;
+    }
+
+    inline std::map<std::string, vector_stats> stats_registry::snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::map<std::string, vector_stats> result;
+        for (const auto& [name, entry] : entries_)
+        {
+            result.emplace(name, entry->snapshot());
+        }
+        return result;
+    }
+
+    // Zeroed stats for instantiations that never allocated
+    inline vector_stats stats_registry::find(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(name);
+        return it == entries_.end() ? vector_stats{} : it->second->snapshot();
+    }
+
+    inline void stats_registry::reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [name, entry] : entries_)
+        {
+            entry->reset();
+        }
+    }
+
+    inline void stats_registry::dump(std::ostream& out) const {
+        for (const auto& [name, s] : snapshot())
+        {
+            out << name << ": allocations=" << s.allocations << " deallocations=" << s.deallocations
+                << " bytes=" << s.bytes_allocated << " reallocations=" << s.reallocations
+                << " moved=" << s.elements_moved << " peak_capacity=" << s.peak_capacity
+                << " wasted_capacity=" << s.wasted_capacity << '\n';
+        }
+    }
+}; // namespace myVector
+
+#endif // MY_VECTOR_STATS_H
@@ -0,0 +1,639 @@
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "my_compare.hpp"
+#include "my_vector.hpp"
+
+// Structure-of-arrays vector: soa_vector<int, double, char> stores three columns (all ints, then
+// all doubles, then all chars) in one buffer, so a loop over one field touches only that
+// field's cache lines. Rows go in and out as std::tuple<Ts...>; *it and v[i] are proxies
+// (soa_reference) that assign through to the columns, so std::ranges::sort and friends
+// reorder whole rows.
+
+namespace myVector
+{
+    // A row of references into the columns. Assigning to it writes the columns, even through a
+    // const proxy, and swap(a, b) swaps the rows themselves.
+    template <bool Const, typename... Ts>
+    class soa_reference
+    {
+        template <typename U>
+        using field_ref = std::conditional_t<Const, const U&, U&>;
+
+      public:
+        using value_type = std::tuple<Ts...>;
+
+        explicit soa_reference(field_ref<Ts>... fields) : fields_(fields...) {}
+
+        // the const proxy is made from the mutable one, like const_iterator from iterator
+        template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        soa_reference(const soa_reference<OtherConst, Ts...>& other) : fields_(other.fields_) {}
+
+        soa_reference(const soa_reference&) = default;
+
+        // clang-format off
+        const soa_reference& operator=(const soa_reference& other) const requires (!Const) { assign(other.fields_); return *this; }
+        const soa_reference& operator=(const value_type& row) const requires (!Const) { assign(row); return *this; }
+        const soa_reference& operator=(value_type&& row) const requires (!Const) { assign(std::move(row)); return *this; }
+        // clang-format on
+
+        operator value_type() const { return std::make_from_tuple<value_type>(fields_); }
+
+        template <std::size_t I>
+        field_ref<std::tuple_element_t<I, value_type>> get() const {
+            return std::get<I>(fields_);
+        }
+
+        template <std::size_t I>
+        friend field_ref<std::tuple_element_t<I, value_type>> get(const soa_reference& row) {
+            return std::get<I>(row.fields_);
+        }
+
+        friend void swap(const soa_reference& a, const soa_reference& b) requires (!Const) {
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                using std::swap;
+                (swap(std::get<I>(a.fields_), std::get<I>(b.fields_)), ...);
+            }(std::index_sequence_for<Ts...>{});
+        }
+
+        friend bool operator==(const soa_reference& a, const soa_reference& b) { return a.fields_ == b.fields_; }
+        friend bool operator==(const soa_reference& a, const value_type& b) { return a.fields_ == b; }
+        friend auto operator<=>(const soa_reference& a, const soa_reference& b) { return a.fields_ <=> b.fields_; }
+        friend auto operator<=>(const soa_reference& a, const value_type& b) { return a.fields_ <=> b; }
+
+      private:
+        std::tuple<field_ref<Ts>...> fields_;
+
+        // field by field: std::tuple<T&...> has no const assignment before C++23's library
+        template <typename Row>
+        void assign(Row&& row) const {
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((std::get<I>(fields_) = std::get<I>(std::forward<Row>(row))), ...);
+            }(std::index_sequence_for<Ts...>{});
+        }
+
+        template <bool, typename...>
+        friend class soa_reference;
+    };
+
+    template <typename... Ts>
+    class soa_vector
+    {
+        static_assert(sizeof...(Ts) > 0, "soa_vector: needs at least one column");
+        static_assert(((alignof(Ts) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) && ...),
+                      "soa_vector: over-aligned columns are not supported");
+
+        using block_type = my_vector<std::byte>; // the one allocation holding every column
+        using columns_type = std::tuple<Ts*...>;
+        using index_sequence = std::index_sequence_for<Ts...>;
+
+        // relocation moves when no column can throw doing so, copies otherwise (like std::vector)
+        static constexpr bool nothrow_relocate = (std::is_nothrow_move_constructible_v<Ts> && ...);
+
+      public:
+        using value_type = std::tuple<Ts...>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = soa_reference<false, Ts...>;
+        using const_reference = soa_reference<true, Ts...>;
+
+        template <std::size_t I>
+        using column_type = std::tuple_element_t<I, value_type>;
+
+        static constexpr size_type column_count = sizeof...(Ts);
+
+      private:
+        block_type   block_;    // raw bytes; elements are constructed by hand
+        columns_type columns_;  // where each column starts inside block_
+        size_type    size_;     // rows
+        size_type    capacity_; // rows every column has room for
+
+        // Helper method declarations
+        static size_type    block_bytes(size_type capacity);
+        static columns_type layout(std::byte* base, size_type capacity) noexcept;
+        void                reallocate(size_type new_capacity);
+        void                destroy_rows(size_type first, size_type last) noexcept;
+        template <typename... Args>
+        void construct_row(size_type index, Args&&... fields);
+        [[nodiscard]] size_type calculate_growth(size_type new_size) const;
+
+      public:
+        template <bool Const>
+        class base_iterator
+        {
+            using columns = std::conditional_t<Const, std::tuple<const Ts*...>, std::tuple<Ts*...>>;
+
+          public:
+            // *it is a proxy, so for the pre-C++20 algorithms this is only an input iterator
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = std::tuple<Ts...>;
+            using difference_type = std::ptrdiff_t;
+            using reference = soa_reference<Const, Ts...>;
+
+            base_iterator() : columns_(), index_(0) {}
+            base_iterator(columns cols, difference_type index) : columns_(cols), index_(index) {}
+
+            template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+            base_iterator(const base_iterator<OtherConst>& other) : columns_(other.columns_), index_(other.index_) {}
+
+            reference operator*() const {
+                return std::apply([this](auto*... column) { return reference(column[index_]...); }, columns_);
+            }
+
+            reference operator[](difference_type n) const { return *(*this + n); }
+
+            // clang-format off
+            base_iterator& operator++() { ++index_; return *this; }
+            base_iterator operator++(int) { base_iterator tmp = *this; ++index_; return tmp; }
+
+            base_iterator& operator--() { --index_; return *this; }
+            base_iterator operator--(int) { base_iterator tmp = *this; --index_; return tmp; }
+
+            base_iterator& operator+=(difference_type n) { index_ += n; return *this; }
+            base_iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+            // clang-format on
+
+            base_iterator operator+(difference_type n) const { return base_iterator(columns_, index_ + n); }
+            base_iterator operator-(difference_type n) const { return base_iterator(columns_, index_ - n); }
+            friend base_iterator operator+(difference_type n, const base_iterator& it) { return it + n; }
+
+            difference_type operator-(const base_iterator& other) const { return index_ - other.index_; }
+
+            bool operator==(const base_iterator& other) const { return index_ == other.index_; }
+            auto operator<=>(const base_iterator& other) const { return index_ <=> other.index_; }
+
+            // what std::ranges algorithms use to move rows out and swap them
+            friend value_type iter_move(const base_iterator& it) {
+                return std::apply(
+                    [&it](auto*... column) {
+                        if constexpr (Const)
+                        {
+                            return value_type(column[it.index_]...);
+                        } else {
+                            return value_type(std::move(column[it.index_])...);
+                        }
+                    },
+                    it.columns_);
+            }
+
+            friend void iter_swap(const base_iterator& a, const base_iterator& b) requires (!Const) { swap(*a, *b); }
+
+          private:
+            columns         columns_;
+            difference_type index_;
+
+            template <bool>
+            friend class base_iterator;
+        };
+
+        using iterator = base_iterator<false>;
+        using const_iterator = base_iterator<true>;
+
+        // Constructor declarations
+        soa_vector() noexcept;
+        soa_vector(std::initializer_list<value_type> rows);
+        soa_vector(const soa_vector& other);
+        soa_vector(soa_vector&& other) noexcept;
+        ~soa_vector();
+
+        soa_vector& operator=(const soa_vector& other);
+        soa_vector& operator=(soa_vector&& other) noexcept;
+
+        // Row access
+        reference       operator[](size_type pos);
+        const_reference operator[](size_type pos) const;
+        reference       at(size_type pos);
+        const_reference at(size_type pos) const;
+        reference       front();
+        const_reference front() const;
+        reference       back();
+        const_reference back() const;
+
+        // Column access: column<1>() is every row's second field, contiguous
+        template <std::size_t I>
+        std::span<column_type<I>> column() noexcept;
+        template <std::size_t I>
+        std::span<const column_type<I>> column() const noexcept;
+
+        // Iterators
+        iterator       begin() noexcept;
+        const_iterator begin() const noexcept;
+        const_iterator cbegin() const noexcept;
+        iterator       end() noexcept;
+        const_iterator end() const noexcept;
+        const_iterator cend() const noexcept;
+
+        // Capacity
+        [[nodiscard]] bool      is_empty() const noexcept;
+        [[nodiscard]] size_type size() const noexcept;
+        [[nodiscard]] size_type max_size() const noexcept;
+        [[nodiscard]] size_type capacity() const noexcept;
+        void                    reserve(size_type new_cap);
+        void                    shrink_to_fit();
+
+        // Modifiers
+        void clear() noexcept;
+        void push_back(const value_type& row);
+        void push_back(value_type&& row);
+        // One argument per column
+        template <typename... Args>
+        reference emplace_back(Args&&... fields);
+        void      pop_back();
+        void      resize(size_type new_size);
+        void      swap(soa_vector& other) noexcept;
+
+        bool operator==(const soa_vector& other) const;
+    };
+
+    // Bytes for `capacity` rows: the columns one after another, each padded to its alignment
+    template <typename... Ts>
+    typename soa_vector<Ts...>::size_type soa_vector<Ts...>::block_bytes(size_type capacity) {
+        size_type bytes = 0;
+        ((bytes = (bytes + alignof(Ts) - 1) / alignof(Ts) * alignof(Ts) + capacity * sizeof(Ts)), ...);
+        return bytes;
+    }
+
+    template <typename... Ts>
+    typename soa_vector<Ts...>::columns_type soa_vector<Ts...>::layout(std::byte* base, size_type capacity) noexcept {
+        size_type offset = 0;
+        auto next = [&]<typename T>(std::type_identity<T>) {
+            offset = (offset + alignof(T) - 1) / alignof(T) * alignof(T);
+            T* column = reinterpret_cast<T*>(base + offset);
+            offset += capacity * sizeof(T);
+            return column;
+        };
+        return columns_type{next(std::type_identity<Ts>{})...};
+    }
+
+    // Moves every column into one new block; strong guarantee, the old block is untouched on failure
+    template <typename... Ts>
+    void soa_vector<Ts...>::reallocate(size_type new_capacity) {
+        block_type block;
+        block.resize_default_init(block_bytes(new_capacity));
+        columns_type columns = layout(block.data(), new_capacity);
+
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            std::size_t relocated = 0; // columns finished so far
+            auto relocate = [&](auto* from, auto* to) {
+                if constexpr (nothrow_relocate)
+                {
+                    std::uninitialized_move_n(from, size_, to);
+                } else {
+                    std::uninitialized_copy_n(from, size_, to);
+                }
+                ++relocated;
+            };
+            try
+            {
+                (relocate(std::get<I>(columns_), std::get<I>(columns)), ...);
+            } catch (...)
+            {
+                ((I < relocated ? std::destroy_n(std::get<I>(columns), size_) : nullptr), ...);
+                throw;
+            }
+        }(index_sequence{});
+
+        destroy_rows(0, size_);
+        block_.swap(block);
+        columns_ = columns;
+        capacity_ = new_capacity;
+    }
+
+    template <typename... Ts>
+    void soa_vector<Ts...>::destroy_rows(size_type first, size_type last) noexcept {
+        std::apply([&](auto*... column) { (std::destroy(column + first, column + last), ...); }, columns_);
+    }
+
+    // Constructs row `index` field by field; on failure the fields already built are destroyed
+    template <typename... Ts>
+    template <typename... Args>
+    void soa_vector<Ts...>::construct_row(size_type index, Args&&... fields) {
+        static_assert(sizeof...(Args) == sizeof...(Ts), "soa_vector: one value per column");
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            std::size_t built = 0;
+            try
+            {
+                ((std::construct_at(std::get<I>(columns_) + index, std::forward<Args>(fields)), ++built), ...);
+            } catch (...)
+            {
+                ((I < built ? std::destroy_at(std::get<I>(columns_) + index) : void()), ...);
+                throw;
+            }
+        }(index_sequence{});
+    }
+
+    template <typename... Ts>
+    typename soa_vector<Ts...>::size_type soa_vector<Ts...>::calculate_growth(size_type new_size) const {
+        if (new_size > max_size())
+        {
+            throw std::length_error("soa_vector::calculate_growth: maximum size exceeded");
+        }
+        return std::clamp(default_growth::next_capacity<value_type>(capacity_, new_size), new_size, max_size());
+    }
+
+    // Constructor implementations
+    template <typename... Ts>
+    soa_vector<Ts...>::soa_vector() noexcept : block_(), columns_(), size_(0), capacity_(0) {}
+
+    template <typename... Ts>
+    soa_vector<Ts...>::soa_vector(std::initializer_list<value_type> rows) : soa_vector() {
+        reserve(rows.size());
+        for (const value_type& row : rows)
+        {
+            push_back(row);
+        }
+    }
+
+    template <typename... Ts>
+    soa_vector<Ts...>::soa_vector(const soa_vector& other) : soa_vector() {
+        reserve(other.size_);
+        for (const_reference row : other)
+        {
+            push_back(value_type(row));
+        }
+    }
+
+    template <typename... Ts>
+    soa_vector<Ts...>::soa_vector(soa_vector&& other) noexcept :
+        block_(std::move(other.block_)), columns_(std::exchange(other.columns_, columns_type())),
+        size_(std::exchange(other.size_, 0)), capacity_(std::exchange(other.capacity_, 0)) {}
+
+    template <typename... Ts>
+    soa_vector<Ts...>::~soa_vector() {
+        destroy_rows(0, size_);
+    }
+
+    template <typename... Ts>
+    soa_vector<Ts...>& soa_vector<Ts...>::operator=(const soa_vector& other) {
+        if (this != &other)
+        {
+            soa_vector copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    template <typename... Ts>
+    soa_vector<Ts...>& soa_vector<Ts...>::operator=(soa_vector&& other) noexcept {
+        if (this != &other)
+        {
+            soa_vector moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    // Row access
+    template <typename... Ts>
+    typename soa_vector<Ts...>::reference soa_vector<Ts...>::operator[](size_type pos) {
+        return begin()[static_cast<difference_type>(pos)];
+    }
+
+    template <typename... Ts>
+    typename soa_vector<Ts...>::const_reference soa_vector<Ts...>::operator[](size_type pos) const {
+        return begin()[static_cast<difference_type>(pos)];
+    }
+
+    template <typename... Ts>
+    typename soa_vector<Ts...>::reference soa_vector<Ts...>::at(size_type pos) {
+        if (pos >= size_)
+        {
+            throw std::out_of_range("soa_vector::at: index out of range");
+        }
+        return (*this)[pos];
+    }
+
+    template <typename... Ts>
+    typename soa_vector<Ts...>::const_reference soa_vector<Ts...>::at(size_type pos) const {
+        if (pos >= size_)
+        {
+            throw std::out_of_range("soa_vector::at: index out of range");
+        }
+        return (*this)[pos];
+    }
+
+    template <typename... Ts>
+    typename soa_vector<Ts...>::reference soa_vector<Ts...>::front() {
+        return (*this)[0];
+    }
+
+    template <typename... Ts>
+    typename soa_vector<Ts...>::const_reference soa_vector<Ts...>::front() const {
+        return (*this)[0];
+    }
+
+    template <typename... Ts>
+    typename soa_vector<Ts...>::reference soa_vector<Ts...>::back() {
+        return (*this)[size_ - 1];
+    }
+
+    template <typename... Ts>
+    typename soa_vector<Ts...>::const_reference soa_vector<Ts...>::back() const {
+        return (*this)[size_ - 1];
+    }
+
+    // Column access
+    template <typename... Ts>
+    template <std::size_t I>
+    std::span<typename soa_vector<Ts...>::template column_type<I>> soa_vector<Ts...>::column() noexcept {
+        return {std::get<I>(columns_), size_};
+    }
+
+    template <typename... Ts>
+    template <std::size_t I>
+    std::span<const typename soa_vector<Ts...>::template column_type<I>> soa_vector<Ts...>::column() const noexcept {
+        return {std::get<I>(columns_), size_};
+    }
+
+    // Iterators
+    template <typename... Ts>
+    typename soa_vector<Ts...>::iterator soa_vector<Ts...>::begin() noexcept {
+        return iterator(columns_, 0);
+    }
+
+    template <typename... Ts>
+    typename soa_vector<Ts...>::const_iterator soa_vector<Ts...>::begin() const noexcept {
+        return const_iterator(std::apply([](auto*... column) { return std::tuple<const Ts*...>(column...); }, columns_), 0);
+    }
+
+    template <typename... Ts>
+    typename soa_vector<Ts...>::const_iterator soa_vector<Ts...>::cbegin() const noexcept {
+        return begin();
+    }
+
+    template <typename... Ts>
+    typename soa_vector<Ts...>::iterator soa_vector<Ts...>::end() noexcept {
+        return begin() + static_cast<difference_type>(size_);
+    }
+
+    template <typename... Ts>
+    typename soa_vector<Ts...>::const_iterator soa_vector<Ts...>::end() const noexcept {
+        return begin() + static_cast<difference_type>(size_);
+    }
+
+    template <typename... Ts>
+    typename soa_vector<Ts...>::const_iterator soa_vector<Ts...>::cend() const noexcept {
+        return end();
+    }
+
+    // Capacity
+    template <typename... Ts>
+    bool soa_vector<Ts...>::is_empty() const noexcept {
+        return size_ == 0;
+    }
+
+    template <typename... Ts>
+    typename soa_vector<Ts...>::size_type soa_vector<Ts...>::size() const noexcept {
+        return size_;
+    }
+
+    // Leaves room for the alignment padding between columns
+    template <typename... Ts>
+    typename soa_vector<Ts...>::size_type soa_vector<Ts...>::max_size() const noexcept {
+        constexpr size_type row_bytes = (sizeof(Ts) + ...);
+        constexpr size_type padding = (alignof(Ts) + ...);
+        return (std::min<size_type>(block_.max_size(), std::numeric_limits<difference_type>::max()) - padding) / row_bytes;
+    }
+
+    template <typename... Ts>
+    typename soa_vector<Ts...>::size_type soa_vector<Ts...>::capacity() const noexcept {
+        return capacity_;
+    }
+
+    template <typename... Ts>
+    void soa_vector<Ts...>::reserve(size_type new_cap) {
+        if (new_cap > capacity_)
+        {
+            if (new_cap > max_size())
+            {
+                throw std::length_error("soa_vector::reserve: maximum size exceeded");
+            }
+            reallocate(new_cap);
+        }
+    }
+
+    template <typename... Ts>
+    void soa_vector<Ts...>::shrink_to_fit() {
+        if (capacity_ > size_)
+        {
+            reallocate(size_);
+        }
+    }
+
+    // Modifiers
+    template <typename... Ts>
+    void soa_vector<Ts...>::clear() noexcept {
+        destroy_rows(0, size_);
+        size_ = 0;
+    }
+
+    template <typename... Ts>
+    void soa_vector<Ts...>::push_back(const value_type& row) {
+        std::apply([this](const Ts&... fields) { emplace_back(fields...); }, row);
+    }
+
+    template <typename... Ts>
+    void soa_vector<Ts...>::push_back(value_type&& row) {
+        std::apply([this](Ts&... fields) { emplace_back(std::move(fields)...); }, row);
+    }
+
+    // The fields may point into this vector, so on growth they are copied out before relocating
+    template <typename... Ts>
+    template <typename... Args>
+    typename soa_vector<Ts...>::reference soa_vector<Ts...>::emplace_back(Args&&... fields) {
+        if (size_ == capacity_)
+        {
+            value_type row(std::forward<Args>(fields)...);
+            reallocate(calculate_growth(size_ + 1));
+            std::apply([this](Ts&... moved) { construct_row(size_, std::move(moved)...); }, row);
+        } else {
+            construct_row(size_, std::forward<Args>(fields)...);
+        }
+        ++size_;
+        return back();
+    }
+
+    template <typename... Ts>
+    void soa_vector<Ts...>::pop_back() {
+        if (size_ > 0)
+        {
+            destroy_rows(size_ - 1, size_);
+            --size_;
+        }
+    }
+
+    template <typename... Ts>
+    void soa_vector<Ts...>::resize(size_type new_size) {
+        if (new_size < size_)
+        {
+            destroy_rows(new_size, size_);
+            size_ = new_size;
+            return;
+        }
+
+        reserve(new_size);
+        while (size_ < new_size)
+        {
+            construct_row(size_, Ts()...);
+            ++size_;
+        }
+    }
+
+    template <typename... Ts>
+    void soa_vector<Ts...>::swap(soa_vector& other) noexcept {
+        block_.swap(other.block_);
+        std::swap(columns_, other.columns_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    // Column by column, each through my_compare.hpp
+    template <typename... Ts>
+    bool soa_vector<Ts...>::operator==(const soa_vector& other) const {
+        return size_ == other.size_ && [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return (equal_elements(std::get<I>(columns_), std::get<I>(other.columns_), size_) && ...);
+        }(index_sequence{});
+    }
+}; // namespace myVector
+
+// A proxy row and a tuple meet at the tuple, so ranges algorithms can mix *it with iter_move(it)
+template <bool Const, typename... Ts, template <typename> class TQual, template <typename> class UQual>
+struct std::basic_common_reference<myVector::soa_reference<Const, Ts...>, std::tuple<Ts...>, TQual, UQual>
+{
+    using type = std::tuple<Ts...>;
+};
+
+template <bool Const, typename... Ts, template <typename> class TQual, template <typename> class UQual>
+struct std::basic_common_reference<std::tuple<Ts...>, myVector::soa_reference<Const, Ts...>, TQual, UQual>
+{
+    using type = std::tuple<Ts...>;
+};
+
+// auto [id, score] = v[i];
+template <bool Const, typename... Ts>
+struct std::tuple_size<myVector::soa_reference<Const, Ts...>> : std::integral_constant<std::size_t, sizeof...(Ts)>
+{};
+
+template <std::size_t I, bool Const, typename... Ts>
+struct std::tuple_element<I, myVector::soa_reference<Const, Ts...>>
+{
+    using type = std::conditional_t<Const, const std::tuple_element_t<I, std::tuple<Ts...>>&,
+                                    std::tuple_element_t<I, std::tuple<Ts...>>&>;
+};
+
+#endif // SOA_VECTOR_H
@@ -1,12 +1,44 @@
 #include "my_array.hpp"
 #include "my_vector.hpp"
+#include "my_allocators.hpp"
+#include "my_small_vector.hpp"
+#include "my_serialization.hpp"
+#include "concurrent_vector.hpp"
+#include "my_segmented_vector.hpp"
+#include "soa_vector.hpp"
+#include "my_simd.hpp"
+#include "my_sort.hpp"
+#if defined(__linux__)
+#include "mmap_vector.hpp"
+#include <unistd.h>
+#endif
 #include <gtest/gtest.h>
 #include <complex>
+#include <cmath>
 #include <vector>
 #include <string>
 #include <array>
 #include <algorithm>
 #include <numeric>
+#include <cstddef>
+#include <cstring>
+#include <list>
+#include <ranges>
+#include <span>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include <sstream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <filesystem>
+#include <atomic>
+#include <execution>
+#include <thread>
+#include <random>
+#include <mutex>
+#include <limits>
 
 
 using myVector::my_vector;
@@ -89,11 +121,131 @@ TEST(MyVectorIterators, StdAlgorithms) {
     EXPECT_EQ(v.front(), 5);
 }
 
+// contiguous iterators
+static_assert(std::contiguous_iterator<my_vector<int>::iterator>);
+static_assert(std::contiguous_iterator<my_vector<int>::const_iterator>);
+static_assert(std::ranges::contiguous_range<my_vector<int>> && std::ranges::sized_range<my_vector<int>>);
+static_assert(std::ranges::contiguous_range<const my_vector<std::string>>);
+static_assert(std::ranges::contiguous_range<my_array<int, 4>> && std::ranges::sized_range<my_array<int, 4>>);
+static_assert(std::ranges::contiguous_range<const my_array<int, 4>>);
+static_assert(std::is_convertible_v<my_vector<int>::iterator, my_vector<int>::const_iterator>);
+static_assert(!std::is_convertible_v<my_vector<int>::const_iterator, my_vector<int>::iterator>);
+
+TEST(MyVectorIterators, Contiguous) {
+    my_vector<int> v{1, 2, 3, 4, 5};
+    const my_vector<int>& cv = v;
+    EXPECT_EQ(std::to_address(v.begin() + 2), v.data() + 2);
+    EXPECT_EQ(std::to_address(cv.end()), v.data() + 5);
+
+    std::span<int> all(v);
+    std::span<const int> tail(cv.begin() + 1, cv.end());
+    EXPECT_EQ(all.size(), 5u);
+    EXPECT_EQ(tail.front(), 2);
+
+    // iterator and const_iterator mix in comparisons, differences and insert/erase positions
+    my_vector<int>::const_iterator c = v.begin();
+    EXPECT_TRUE(v.begin() == c);
+    EXPECT_TRUE(c < v.end());
+    EXPECT_EQ(v.end() - c, 5);
+    EXPECT_EQ(c - v.end(), -5);
+    EXPECT_EQ(v.begin() <=> cv.begin() + 1, std::strong_ordering::less);
+    EXPECT_EQ(2 + v.begin(), v.begin() + 2);
+    v.insert(v.begin() + 1, 9);
+    v.erase(v.begin());
+    EXPECT_EQ(v, (my_vector<int>{9, 2, 3, 4, 5}));
+
+    int out[5] = {};
+    std::ranges::copy(v, out);
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), out));
+}
+
+#if MY_VECTOR_ASSERTIONS
+// StdVectorArray_checked_tests: each misuse aborts with the failed condition
+TEST(MyVectorChecks, BoundsAndEmptyAccess) {
+    my_vector<int> v{1, 2, 3};
+    const my_vector<int>& cv = v;
+    EXPECT_EQ(v[2], 3);
+    EXPECT_DEATH((void)v[3], "pos < size_");
+    EXPECT_DEATH((void)cv[100], "pos < size_");
+
+    my_vector<int> empty;
+    const my_vector<int>& cempty = empty;
+    EXPECT_DEATH((void)empty.front(), "size_ > 0");
+    EXPECT_DEATH((void)cempty.back(), "size_ > 0");
+    EXPECT_DEATH(empty.pop_back(), "size_ > 0");
+    EXPECT_THROW((void)empty.at(0), std::out_of_range);
+}
+
+TEST(MyVectorChecks, StaleIterators) {
+    my_vector<int> v{1, 2, 3};
+    v.reserve(4);
+    auto it = v.begin();
+    v.push_back(4); // fits, the buffer stays
+    EXPECT_EQ(*it, 1);
+    v.push_back(5); // reallocates
+    EXPECT_DEATH((void)*it, "stamp_.valid\\(\\)");
+    EXPECT_DEATH((void)it[1], "stamp_.valid\\(\\)");
+    EXPECT_DEATH(v.insert(it, 0), "stamp_.valid\\(\\)");
+    EXPECT_DEATH(v.erase(it), "stamp_.valid\\(\\)");
+
+    auto before_shrink = v.cbegin() + 1;
+    v.clear();
+    v.shrink_to_fit(); // frees the buffer
+    EXPECT_DEATH((void)*before_shrink, "stamp_.valid\\(\\)");
+
+    my_vector<std::string>::iterator dangling;
+    {
+        my_vector<std::string> scoped{"a", "b"};
+        dangling = scoped.begin();
+        EXPECT_EQ(dangling->size(), 1u);
+    }
+    EXPECT_DEATH((void)dangling->size(), "stamp_.valid\\(\\)");
+}
+
+TEST(MyVectorChecks, IteratorsFollowMoveAndSwap) {
+    my_vector<int> a{1, 2, 3};
+    my_vector<int> b{4, 5};
+    auto in_a = a.begin() + 1;
+    auto in_b = b.begin();
+
+    a.swap(b);
+    EXPECT_EQ(*in_a, 2);
+    EXPECT_EQ(*in_b, 4);
+    b.push_back(6); // b now owns the buffer in_a points into
+    EXPECT_DEATH((void)*in_a, "stamp_.valid\\(\\)");
+    EXPECT_EQ(*in_b, 4);
+
+    my_vector<int> moved(std::move(a));
+    EXPECT_EQ(*in_b, 4);
+    a = my_vector<int>{7};
+    EXPECT_EQ(*in_b, 4);
+    moved.clear();
+    moved.shrink_to_fit();
+    EXPECT_DEATH((void)*in_b, "stamp_.valid\\(\\)");
+
+    // copies get a buffer of their own
+    my_vector<int> original{1, 2};
+    auto in_original = original.begin();
+    my_vector<int> copy(original);
+    copy.reserve(100);
+    EXPECT_EQ(*in_original, 1);
+}
+#else
+// unchecked, the iterator is a bare pointer and my_vector has nothing beyond its buffer
+static_assert(sizeof(my_vector<int>::iterator) == sizeof(int*) && std::is_trivially_copyable_v<my_vector<int>::iterator>);
+static_assert(sizeof(my_vector<int>) == 3 * sizeof(void*));
+
+TEST(MyVectorChecks, UncheckedPopBackOnEmpty) {
+    my_vector<int> v;
+    v.pop_back();
+    EXPECT_TRUE(v.is_empty());
+}
+#endif
+
 // insert & erase variants
 TEST(MyVectorInsertErase, SingleInsertErase) {
     my_vector<int> v{1, 3};
-    auto it = v.begin() + 1;
-    v.insert(v.cbegin(), 2);
+    v.insert(v.cbegin() + 1, 2);
     EXPECT_EQ(v.size(), 3u);
     EXPECT_EQ(v[1], 2);
     v.erase(v.cbegin());
@@ -129,6 +281,10 @@ TEST(MyVectorCapacity, AssignAndReserve) {
     EXPECT_GE(v.capacity(), 10u);
     v.shrink_to_fit();
     EXPECT_EQ(v.capacity(), 3u);
+    v.clear();
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 0u);
+    EXPECT_EQ(v.data(), nullptr);
 }
 
 // copyig move and comparison
@@ -154,6 +310,1242 @@ TEST(MyVectorComplex, StdComplex) {
     EXPECT_EQ(v.back(), cd(3,4));
 }
 
+// relocation fast path
+namespace {
+    struct Tracked {
+        static inline int destroyed = 0;
+        int value;
+        explicit Tracked(int v) : value(v) {}
+        Tracked(const Tracked&) = default;
+        ~Tracked() { ++destroyed; }
+    };
+}
+template <>
+struct myVector::is_trivially_relocatable<Tracked> : std::true_type {};
+
+TEST(MyVectorRelocation, UniquePtrSurvivesGrowth) {
+    static_assert(myVector::is_trivially_relocatable_v<std::unique_ptr<int>>);
+    my_vector<std::unique_ptr<int>> v;
+    for (int i = 0; i < 100; ++i) v.push_back(std::make_unique<int>(i));
+    v.insert(v.cbegin() + 50, std::make_unique<int>(-1));
+    v.insert(v.cbegin(), nullptr);
+    ASSERT_EQ(v.size(), 102u);
+    EXPECT_EQ(v[0], nullptr);
+    EXPECT_EQ(*v[1], 0);
+    EXPECT_EQ(*v[51], -1);
+    EXPECT_EQ(*v.back(), 99);
+}
+
+TEST(MyVectorRelocation, GrowthSkipsDestructors) {
+    my_vector<Tracked> v;
+    v.reserve(1);
+    v.emplace_back(1);
+    Tracked::destroyed = 0;
+    for (int i = 2; i <= 64; ++i) v.emplace_back(i);
+    v.shrink_to_fit();
+    EXPECT_EQ(Tracked::destroyed, 0);
+    for (int i = 0; i < 64; ++i) EXPECT_EQ(v[i].value, i + 1);
+}
+
+TEST(MyVectorRelocation, NestedVectors) {
+    static_assert(myVector::is_trivially_relocatable_v<my_vector<int>>);
+    my_vector<my_vector<int>> v;
+    for (int i = 0; i < 20; ++i) v.push_back(my_vector<int>(static_cast<size_t>(i), i));
+    v.insert(v.cbegin(), my_vector<int>{7, 7});
+    EXPECT_EQ(v.size(), 21u);
+    EXPECT_EQ(v[0], (my_vector<int>{7, 7}));
+    EXPECT_EQ(v[20].size(), 19u);
+    EXPECT_EQ(v[20][18], 19);
+}
+
+// allocator awareness
+namespace {
+    struct AllocStats {
+        int allocations = 0;
+        int deallocations = 0;
+    };
+
+    template <typename T, bool Propagate = false>
+    struct CountingAllocator {
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+        using propagate_on_container_move_assignment = std::bool_constant<Propagate>;
+        using propagate_on_container_swap = std::bool_constant<Propagate>;
+        using is_always_equal = std::false_type;
+
+        AllocStats* stats;
+
+        explicit CountingAllocator(AllocStats* s) : stats(s) {}
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U, Propagate>& other) : stats(other.stats) {}
+        template <typename U>
+        struct rebind { using other = CountingAllocator<U, Propagate>; };
+
+        T* allocate(std::size_t n) { ++stats->allocations; return std::allocator<T>{}.allocate(n); }
+        void deallocate(T* p, std::size_t n) { ++stats->deallocations; std::allocator<T>{}.deallocate(p, n); }
+        friend bool operator==(const CountingAllocator& a, const CountingAllocator& b) { return a.stats == b.stats; }
+    };
+}
+
+TEST(MyVectorAllocator, ReserveAllocatesOnce) {
+    AllocStats stats;
+    {
+        my_vector<int, CountingAllocator<int>> v{CountingAllocator<int>(&stats)};
+        v.reserve(100);
+        for (int i = 0; i < 100; ++i) v.push_back(i);
+        EXPECT_EQ(stats.allocations, 1);
+    }
+    EXPECT_EQ(stats.deallocations, 1);
+}
+
+TEST(MyVectorAllocator, OneAllocationPerGrowth) {
+    AllocStats stats;
+    {
+        my_vector<std::string, CountingAllocator<std::string>> v{CountingAllocator<std::string>(&stats)};
+        int growths = 0;
+        for (int i = 0; i < 1000; ++i) {
+            auto cap = v.capacity();
+            v.emplace_back(std::to_string(i));
+            if (v.capacity() != cap) ++growths;
+        }
+        EXPECT_EQ(stats.allocations, growths);
+        auto copy = v;
+        EXPECT_EQ(stats.allocations, growths + 1);
+        EXPECT_EQ(copy.get_allocator().stats, &stats);
+    }
+    EXPECT_EQ(stats.deallocations, stats.allocations);
+}
+
+TEST(MyVectorAllocator, MoveAssignUnequalAllocators) {
+    AllocStats left_stats, right_stats;
+    {
+        using Alloc = CountingAllocator<int>;
+        my_vector<int, Alloc> left({1, 2, 3}, Alloc(&left_stats));
+        my_vector<int, Alloc> right({4, 5, 6, 7}, Alloc(&right_stats));
+        left = std::move(right);
+        EXPECT_EQ(left, (my_vector<int, Alloc>({4, 5, 6, 7}, Alloc(&left_stats))));
+        EXPECT_EQ(left.get_allocator().stats, &left_stats);
+        EXPECT_EQ(right_stats.allocations, 1);
+    }
+    EXPECT_EQ(left_stats.deallocations, left_stats.allocations);
+    EXPECT_EQ(right_stats.deallocations, right_stats.allocations);
+}
+
+TEST(MyVectorAllocator, PropagatingAllocatorFollowsBuffer) {
+    AllocStats left_stats, right_stats;
+    {
+        using Alloc = CountingAllocator<int, true>;
+        my_vector<int, Alloc> left({1, 2, 3}, Alloc(&left_stats));
+        my_vector<int, Alloc> right({4, 5}, Alloc(&right_stats));
+        left.swap(right);
+        EXPECT_EQ(left.get_allocator().stats, &right_stats);
+        left = std::move(right);
+        EXPECT_EQ(left.get_allocator().stats, &left_stats);
+        EXPECT_EQ(left.size(), 3u);
+    }
+    EXPECT_EQ(left_stats.deallocations, left_stats.allocations);
+    EXPECT_EQ(right_stats.deallocations, right_stats.allocations);
+}
+
+TEST(MyVectorAllocator, MonotonicResource) {
+    std::byte buffer[4096];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    my_vector<int, std::pmr::polymorphic_allocator<int>> v(&arena);
+    for (int i = 0; i < 64; ++i) v.push_back(i);
+    EXPECT_EQ(v.size(), 64u);
+    EXPECT_EQ(v[63], 63);
+    EXPECT_EQ(v.get_allocator().resource(), &arena);
+}
+
+TEST(MyVectorAllocator, ReallocAcrossMmapThreshold) {
+    // 4 KiB threshold: small blocks use realloc, large ones mremap
+    using Vec = my_vector<int, myVector::realloc_allocator<int, 4096>>;
+    Vec v;
+    for (int i = 0; i < 100000; ++i) v.push_back(i);
+    v.insert(v.cbegin(), -1);
+    v.erase(v.cbegin() + 1, v.cbegin() + 50002);
+    ASSERT_EQ(v.size(), 50000u);
+    EXPECT_EQ(v[0], -1);
+    EXPECT_EQ(v[1], 50001);
+    v.shrink_to_fit();
+    v.resize(100);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 100u);
+    EXPECT_EQ(v.back(), 50099);
+    v.push_back(v[0]);
+    EXPECT_EQ(v.back(), -1);
+}
+
+TEST(MyVectorAllocator, AlignedAndHugePageBlocks) {
+    auto offset = [](const void* p, std::size_t alignment) { return reinterpret_cast<std::uintptr_t>(p) % alignment; };
+
+    my_vector<float, myVector::aligned_allocator<float, 64>> a;
+    for (int i = 0; i < 1000; ++i) {
+        a.push_back(static_cast<float>(i));
+        ASSERT_EQ(offset(a.data(), 64), 0u);
+    }
+    EXPECT_EQ(a[999], 999.0f);
+
+    // 64 KiB threshold: the first blocks are aligned heap blocks, then huge-page mappings
+    constexpr std::size_t huge = std::size_t{2} << 20;
+    my_vector<double, myVector::huge_page_allocator<double, std::size_t{1} << 16>> h;
+    for (int i = 0; i < 300'000; ++i) {
+        h.push_back(i);
+    }
+    EXPECT_EQ(offset(h.data(), huge), 0u);
+    EXPECT_EQ(h[299'999], 299'999.0);
+    h.resize(10);
+    h.shrink_to_fit();
+    EXPECT_EQ(offset(h.data(), 64), 0u);
+    EXPECT_EQ(h.back(), 9.0);
+}
+
+// bulk append
+TEST(MyVectorAppend, AppendRangeGrowsOnce) {
+    AllocStats stats;
+    my_vector<int, CountingAllocator<int>> v{CountingAllocator<int>(&stats)};
+    std::vector<int> src(1000);
+    std::iota(src.begin(), src.end(), 0);
+    v.append_range(src);
+    EXPECT_EQ(stats.allocations, 1);
+    v.append(src.begin(), src.begin() + 10);
+    EXPECT_EQ(stats.allocations, 2);
+    ASSERT_EQ(v.size(), 1010u);
+    EXPECT_EQ(v[999], 999);
+    EXPECT_EQ(v[1009], 9);
+}
+
+TEST(MyVectorAppend, NonContiguousAndInputSources) {
+    my_vector<std::string> v{"a"};
+    std::list<std::string> words{"b", "c"};
+    v.append(words.begin(), words.end());
+    v.append_range(words | std::views::reverse);
+    std::istringstream in("d e");
+    v.append_range(std::views::istream<std::string>(in));
+    v.append_n(2, "f");
+    EXPECT_EQ(v, (my_vector<std::string>{"a", "b", "c", "c", "b", "d", "e", "f", "f"}));
+}
+
+TEST(MyVectorAppend, SelfAppend) {
+    my_vector<std::string> v{"x", "y"};
+    v.shrink_to_fit();
+    v.append(v.begin(), v.end());
+    v.append_n(1, v.front());
+    EXPECT_EQ(v, (my_vector<std::string>{"x", "y", "x", "y", "x"}));
+}
+
+// single-pass range insert/assign
+TEST(MyVectorRangeInsert, ForwardRangeAllocatesOnce) {
+    AllocStats stats;
+    my_vector<int, CountingAllocator<int>> v({1, 2}, CountingAllocator<int>(&stats));
+    std::list<int> src(1000, 7);
+    v.insert(v.cbegin() + 1, src.begin(), src.end());
+    EXPECT_EQ(stats.allocations, 2);
+    ASSERT_EQ(v.size(), 1002u);
+    EXPECT_EQ(v[0], 1);
+    EXPECT_EQ(v[1000], 7);
+    EXPECT_EQ(v[1001], 2);
+    v.assign(src.begin(), std::next(src.begin(), 10));
+    EXPECT_EQ(stats.allocations, 2);
+    EXPECT_EQ(v.size(), 10u);
+}
+
+TEST(MyVectorRangeInsert, InputIterators) {
+    my_vector<std::string> v{"a", "z"};
+    std::istringstream in("b c d");
+    auto it = v.insert(v.cbegin() + 1, std::istream_iterator<std::string>(in), std::istream_iterator<std::string>());
+    EXPECT_EQ(it - v.begin(), 1);
+    EXPECT_EQ(v, (my_vector<std::string>{"a", "b", "c", "d", "z"}));
+    std::istringstream again("x y");
+    v.assign(std::istream_iterator<std::string>(again), std::istream_iterator<std::string>());
+    EXPECT_EQ(v, (my_vector<std::string>{"x", "y"}));
+}
+
+// mid-vector insert/erase
+TEST(MyVectorShift, NonTrivialElements) {
+    my_vector<std::string> v{"a", "b", "c", "d"};
+    v.reserve(16);
+    v.insert(v.cbegin() + 1, 3, std::string(40, 'x'));
+    v.insert(v.cbegin() + 5, v[0]);
+    v.erase(v.cbegin() + 1, v.cbegin() + 3);
+    EXPECT_EQ(v, (my_vector<std::string>{"a", std::string(40, 'x'), "b", "a", "c", "d"}));
+    v.erase(v.cbegin() + 4, v.cend());
+    v.insert(v.cend(), 2, "e");
+    EXPECT_EQ(v, (my_vector<std::string>{"a", std::string(40, 'x'), "b", "a", "e", "e"}));
+}
+
+TEST(MyVectorShift, TriviallyRelocatableElements) {
+    my_vector<std::unique_ptr<int>> v;
+    v.reserve(8);
+    for (int i = 0; i < 5; ++i) v.push_back(std::make_unique<int>(i));
+    v.insert(v.cbegin() + 2, std::make_unique<int>(42));
+    v.erase(v.cbegin());
+    ASSERT_EQ(v.size(), 5u);
+    EXPECT_EQ(*v[1], 42);
+    EXPECT_EQ(*v[4], 4);
+}
+
+namespace {
+    struct ThrowOnCopy
+    {
+        static inline int budget = 0;
+        int value;
+        ThrowOnCopy(int v) : value(v) {}
+        ThrowOnCopy(const ThrowOnCopy& other) : value(other.value) {
+            if (budget-- == 0) throw std::runtime_error("copy");
+        }
+        ThrowOnCopy(ThrowOnCopy&&) noexcept = default;
+        ThrowOnCopy& operator=(const ThrowOnCopy&) = default;
+        ThrowOnCopy& operator=(ThrowOnCopy&&) noexcept = default;
+        bool operator==(const ThrowOnCopy&) const = default;
+    };
+}
+
+TEST(MyVectorShift, FailedInsertClosesTheGap) {
+    ThrowOnCopy::budget = 100;
+    my_vector<ThrowOnCopy> v{1, 2, 3};
+    v.reserve(10);
+    ThrowOnCopy::budget = 2; // the local copy and one element succeed
+    EXPECT_THROW(v.insert(v.cbegin() + 1, 3, ThrowOnCopy(9)), std::runtime_error);
+    ThrowOnCopy::budget = 100;
+    EXPECT_EQ(v, (my_vector<ThrowOnCopy>{1, 2, 3}));
+}
+
+#if MY_VECTOR_INSTRUMENTATION
+// allocation instrumentation
+namespace {
+    struct StatsProbe { int value; };
+}
+
+TEST(MyVectorStats, CountsGrowth) {
+    using Vec = my_vector<StatsProbe>;
+    {
+        Vec v;
+        for (int i = 0; i < 10; ++i) v.push_back({i}); // capacities 1, 2, 3, 4, 6, 9, 13
+        v.insert(v.cbegin(), {-1});
+    }
+    auto s = myVector::stats_of<Vec>();
+    EXPECT_EQ(s.allocations, 7u);
+    EXPECT_EQ(s.deallocations, 7u);
+    EXPECT_EQ(s.bytes_allocated, 38 * sizeof(StatsProbe));
+    EXPECT_EQ(s.reallocations, 6u);
+    EXPECT_EQ(s.elements_moved, 25u);
+    EXPECT_EQ(s.peak_capacity, 13u);
+    EXPECT_EQ(s.wasted_capacity, 2u);
+
+    std::ostringstream out;
+    myVector::stats_registry::instance().dump(out);
+    EXPECT_NE(out.str().find("StatsProbe"), std::string::npos);
+}
+#endif
+
+#if defined(__linux__)
+// file-backed vector
+namespace {
+    // prefixed with the pid, so the default and checked test binaries can run at the same time
+    std::string temp_path(const char* name) {
+        return (std::filesystem::temp_directory_path() / (std::to_string(::getpid()) + "_" + name)).string();
+    }
+}
+
+TEST(MmapVector, PersistsAcrossOpen) {
+    const std::string path = temp_path("mmap_vector_persist.bin");
+    std::filesystem::remove(path);
+    {
+        myVector::mmap_vector<int> v(path);
+        EXPECT_TRUE(v.is_empty());
+        for (int i = 0; i < 100000; ++i) v.push_back(i);
+        v.insert(v.cbegin(), {-2, -1});
+        v.erase(v.cbegin() + 2);
+        v.flush();
+        EXPECT_GE(v.capacity(), v.size());
+    }
+    EXPECT_EQ(std::filesystem::file_size(path), 100001 * sizeof(int));
+
+    myVector::mmap_vector<int> v(path);
+    ASSERT_EQ(v.size(), 100001u);
+    EXPECT_EQ(v[0], -2);
+    EXPECT_EQ(v[1], -1);
+    EXPECT_EQ(v[2], 1);
+    EXPECT_EQ(v.back(), 99999);
+    v.resize(10);
+    v.shrink_to_fit();
+    v.close();
+    EXPECT_EQ(std::filesystem::file_size(path), 10 * sizeof(int));
+    std::filesystem::remove(path);
+}
+
+TEST(MmapVector, ReadOnlyIsPrivate) {
+    const std::string path = temp_path("mmap_vector_readonly.bin");
+    {
+        myVector::mmap_vector<int> v(path);
+        v.assign({1, 2, 3});
+    }
+    {
+        myVector::mmap_vector<int> v(path, myVector::mmap_mode::read_only);
+        EXPECT_TRUE(v.is_read_only());
+        v[0] = 42; // copy-on-write, stays in this process
+        EXPECT_EQ(v[0], 42);
+        EXPECT_THROW(v.push_back(4), std::logic_error);
+    }
+    myVector::mmap_vector<int> v(path, myVector::mmap_mode::read_only);
+    EXPECT_EQ(v[0], 1);
+    EXPECT_EQ(v.size(), 3u);
+    v.close();
+    std::filesystem::remove(path);
+}
+#endif
+
+// binary snapshots
+TEST(MyVectorSerialization, FlatRoundTrip) {
+    my_vector<double> v(1000);
+    std::iota(v.begin(), v.end(), 0.5);
+    std::stringstream buffer;
+    myVector::write_to(buffer, v);
+    EXPECT_EQ(buffer.str().size(), sizeof(myVector::serial_header) + 1000 * sizeof(double));
+
+    my_vector<double> back{1.0};
+    myVector::read_from(buffer, back);
+    EXPECT_EQ(back, v);
+
+    my_array<int, 4> a{1, 2, 3, 4};
+    std::stringstream array_buffer;
+    myVector::write_to(array_buffer, a);
+    my_array<int, 4> a2{};
+    myVector::read_from(array_buffer, a2);
+    EXPECT_EQ(a2, a);
+}
+
+TEST(MyVectorSerialization, RejectsDamagedSnapshots) {
+    my_vector<int> v{1, 2, 3};
+    std::stringstream buffer;
+    myVector::write_to(buffer, v);
+    std::string bytes = buffer.str();
+
+    std::string damaged = bytes;
+    damaged.back() ^= 1;
+    std::istringstream in(damaged);
+    my_vector<int> out{4, 5};
+    EXPECT_THROW(myVector::read_from(in, out), myVector::serialization_error);
+    EXPECT_EQ(out, (my_vector<int>{4, 5})); // a failed read leaves the target alone
+
+    // counts whose byte sizes wrap around 64 bits
+    std::string huge = bytes;
+    const std::uint64_t wrapping_count = (std::uint64_t{1} << 62) + 3;
+    std::memcpy(huge.data() + offsetof(myVector::serial_header, count), &wrapping_count, sizeof(wrapping_count));
+    std::istringstream huge_in(huge);
+    EXPECT_THROW(myVector::read_from(huge_in, out), myVector::serialization_error);
+    EXPECT_EQ(out.size(), 2u);
+
+    std::istringstream truncated(bytes.substr(0, bytes.size() - 1));
+    EXPECT_THROW(myVector::read_from(truncated, out), myVector::serialization_error);
+
+    std::istringstream wrong_type(bytes);
+    my_vector<double> doubles;
+    EXPECT_THROW(myVector::read_from(wrong_type, doubles), myVector::serialization_error);
+
+    std::istringstream wrong_size(bytes);
+    my_array<int, 4> a{};
+    EXPECT_THROW(myVector::read_from(wrong_size, a), myVector::serialization_error);
+}
+
+TEST(MyVectorSerialization, NestedAndViews) {
+    my_vector<my_vector<int>> nested{{1, 2}, {}, {3, 4, 5}};
+    std::stringstream buffer;
+    myVector::write_to(buffer, nested);
+    std::string bytes = buffer.str();
+
+    my_vector<my_vector<int>> back;
+    std::istringstream in(bytes);
+    myVector::read_from(in, back);
+    EXPECT_EQ(back, nested);
+
+    // a count of UINT64_MAX would need UINT64_MAX + 1 offsets; damaged offsets leave back as it was
+    std::string huge = bytes;
+    const std::uint64_t max_count = std::numeric_limits<std::uint64_t>::max();
+    std::memcpy(huge.data() + offsetof(myVector::serial_header, count), &max_count, sizeof(max_count));
+    std::istringstream huge_in(huge);
+    EXPECT_THROW(myVector::read_from(huge_in, back), myVector::serialization_error);
+    std::string unordered = bytes;
+    const std::uint64_t past_next = 4; // offsets are 0, 2, 2, 5
+    std::memcpy(unordered.data() + sizeof(myVector::serial_header) + 2 * sizeof(std::uint64_t), &past_next, sizeof(past_next));
+    std::istringstream unordered_in(unordered);
+    EXPECT_THROW(myVector::read_from(unordered_in, back), myVector::serialization_error);
+    EXPECT_EQ(back, nested);
+
+    // std::string storage is only char-aligned, view from an aligned copy
+    my_vector<std::uint64_t> aligned((bytes.size() + 7) / 8);
+    std::memcpy(aligned.data(), bytes.data(), bytes.size());
+    auto view = myVector::nested_view_from_buffer<int>(std::as_bytes(std::span(aligned.data(), aligned.size())).first(bytes.size()));
+    ASSERT_EQ(view.size(), 3u);
+    EXPECT_TRUE(view[1].empty());
+    EXPECT_EQ(view[2][2], 5);
+
+    my_vector<int> flat{7, 8, 9};
+    std::stringstream flat_buffer;
+    myVector::write_to(flat_buffer, flat);
+    std::string flat_bytes = flat_buffer.str();
+    std::memcpy(aligned.data(), flat_bytes.data(), flat_bytes.size());
+    auto span = myVector::view_from_buffer<int>(std::as_bytes(std::span(aligned.data(), aligned.size())).first(flat_bytes.size()));
+    ASSERT_EQ(span.size(), 3u);
+    EXPECT_EQ(span[2], 9);
+    EXPECT_EQ(static_cast<const void*>(span.data()), static_cast<const void*>(reinterpret_cast<const std::byte*>(aligned.data()) + 64));
+}
+
+#if defined(__linux__)
+TEST(MyVectorSerialization, FileDescriptors) {
+    const std::string path = temp_path("my_vector_snapshot.bin");
+    my_vector<long> v(100000);
+    std::iota(v.begin(), v.end(), -50000L);
+    int fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+    ASSERT_GE(fd, 0);
+    myVector::write_to(fd, v);
+    ::lseek(fd, 0, SEEK_SET);
+    my_vector<long> back;
+    myVector::read_from(fd, back);
+    ::close(fd);
+    EXPECT_EQ(back, v);
+
+    myVector::mmap_vector<std::byte> mapped(path, myVector::mmap_mode::read_only);
+    auto view = myVector::view_from_buffer<long>(std::span<const std::byte>(mapped.data(), mapped.size()));
+    EXPECT_TRUE(std::equal(view.begin(), view.end(), v.begin()));
+    mapped.close();
+    std::filesystem::remove(path);
+}
+#endif
+
+// vectorized comparisons
+TEST(MyVectorCompare, FirstDifferenceAnywhere) {
+    // every length up to a few SIMD blocks, with the difference at every position
+    for (std::size_t n = 1; n < 70; ++n) {
+        my_vector<std::uint8_t> a(n, 7);
+        my_vector<long long> c(n, -3);
+        for (std::size_t i = 0; i < n; ++i) {
+            my_vector<std::uint8_t> b = a;
+            b[i] = 9;
+            EXPECT_EQ(myVector::mismatch_index(a.data(), b.data(), n), i);
+            EXPECT_TRUE(a < b);
+            EXPECT_FALSE(a == b);
+
+            my_vector<long long> d = c;
+            d[i] = -4;
+            EXPECT_TRUE(c > d);
+        }
+        EXPECT_EQ(a, my_vector<std::uint8_t>(n, 7));
+    }
+}
+
+TEST(MyVectorCompare, FloatingPointSemantics) {
+    my_vector<double> a(40, 1.0), b(40, 1.0);
+    a[17] = 0.0;
+    b[17] = -0.0;
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a <=> b, std::partial_ordering::equivalent);
+    b[33] = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_NE(a, b);
+    EXPECT_EQ(a <=> b, std::partial_ordering::unordered);
+
+    my_vector<float> f(20, 2.0f), g(20, 2.0f);
+    g[19] = 3.0f;
+    EXPECT_EQ(f <=> g, std::partial_ordering::less);
+}
+
+TEST(MyArrayCompare, MatchesDefaultedComparisons) {
+    static_assert(my_array<int, 3>{1, 2, 3} < my_array<int, 3>{1, 2, 4});
+    static_assert(my_array<int, 3>{1, 2, 3} == my_array<int, 3>{1, 2, 3});
+    my_array<unsigned, 40> a{};
+    my_array<unsigned, 40> b{};
+    a.fill(5);
+    b.fill(5);
+    EXPECT_EQ(a, b);
+    b[39] = 4;
+    EXPECT_GT(a, b);
+    my_array<std::string, 2> s1{"a", "b"}, s2{"a", "c"};
+    EXPECT_LT(s1, s2);
+}
+
+// parallel construction
+namespace {
+    // lowers the parallel threshold so small vectors get split into chunks
+    struct ParallelThreshold
+    {
+        std::size_t saved = myVector::parallel_threshold_bytes.exchange(0);
+        ~ParallelThreshold() { myVector::parallel_threshold_bytes = saved; }
+    };
+
+    struct ChunkProbe
+    {
+        static inline std::atomic<int> alive = 0;
+        int value;
+        ChunkProbe(int v) : value(v) { ++alive; }
+        ChunkProbe(const ChunkProbe& other) : value(other.value) {
+            if (value < 0) throw std::runtime_error("copy");
+            ++alive;
+        }
+        ~ChunkProbe() { --alive; }
+    };
+}
+
+TEST(MyVectorParallel, FillCopyTransform) {
+    ParallelThreshold threshold;
+    my_vector<int> filled(std::execution::par, 100'000, 7);
+    EXPECT_EQ(filled, my_vector<int>(100'000, 7));
+
+    std::vector<int> source(100'003);
+    std::iota(source.begin(), source.end(), 0);
+    my_vector<int> copied(std::execution::par, source.begin(), source.end());
+    EXPECT_TRUE(std::equal(copied.begin(), copied.end(), source.begin(), source.end()));
+    my_vector<int> again(std::execution::par_unseq, copied);
+    EXPECT_EQ(again, copied);
+
+    my_vector<std::string> text;
+    text.assign_transformed(std::execution::par, source.begin(), source.end(), [](int x) { return std::to_string(x); });
+    ASSERT_EQ(text.size(), source.size());
+    EXPECT_EQ(text[100'002], "100002");
+
+    filled.resize(std::execution::par, 250'000, 1);
+    EXPECT_EQ(filled[99'999], 7);
+    EXPECT_EQ(filled[100'000], 1);
+    EXPECT_EQ(std::count(filled.begin(), filled.end(), 1), 150'000);
+    filled.assign(std::execution::seq, 3, 2);
+    EXPECT_EQ(filled, (my_vector<int>{2, 2, 2}));
+}
+
+TEST(MyVectorParallel, FailedChunkDestroysTheRest) {
+    ParallelThreshold threshold;
+    std::vector<ChunkProbe> source(20'000, ChunkProbe(1));
+    source[15'000].value = -1;
+    const int before = ChunkProbe::alive;
+    EXPECT_THROW(my_vector<ChunkProbe>(std::execution::par, source.begin(), source.end()), std::runtime_error);
+    EXPECT_EQ(ChunkProbe::alive, before);
+
+    my_vector<ChunkProbe> v;
+    EXPECT_THROW(v.assign(std::execution::par, source.begin(), source.end()), std::runtime_error);
+    EXPECT_TRUE(v.is_empty());
+    EXPECT_EQ(ChunkProbe::alive, before);
+}
+
+// parallel sort
+namespace {
+    // splits even small vectors into an odd number of runs
+    struct SortThreads
+    {
+        ParallelThreshold threshold;
+        std::size_t saved = myVector::parallel_sort_threads.exchange(7);
+        ~SortThreads() { myVector::parallel_sort_threads = saved; }
+    };
+
+    struct Keyed
+    {
+        int key;
+        int order;
+        bool operator==(const Keyed&) const = default;
+    };
+}
+
+TEST(MyVectorSort, RadixMatchesStdSort) {
+    SortThreads threads;
+    std::mt19937_64 rng(42);
+    my_vector<std::int64_t> wide;
+    my_vector<std::uint8_t> narrow;
+    my_vector<double> real;
+    for (int i = 0; i < 50'000; ++i) {
+        wide.push_back(static_cast<std::int64_t>(rng()) >> (i % 40));
+        narrow.push_back(static_cast<std::uint8_t>(rng()));
+        real.push_back(std::ldexp(static_cast<double>(static_cast<std::int64_t>(rng())), -60 + i % 80));
+    }
+    real[10] = -std::numeric_limits<double>::infinity();
+    real[20] = std::numeric_limits<double>::infinity();
+    real[30] = std::numeric_limits<double>::denorm_min();
+
+    auto expect_sorted = [](auto v, auto comp) {
+        auto expected = v;
+        std::sort(expected.begin(), expected.end(), comp);
+        myVector::parallel_sort(v, comp);
+        EXPECT_EQ(v, expected);
+    };
+    expect_sorted(wide, std::less<>{});
+    expect_sorted(wide, std::greater<std::int64_t>{});
+    expect_sorted(narrow, std::less<>{});
+    expect_sorted(real, std::less<double>{});
+    expect_sorted(real, std::greater<>{});
+    expect_sorted(my_vector<int>(10'000, -3), std::less<>{});
+}
+
+TEST(MyVectorSort, StableKeepsEquivalentOrder) {
+    SortThreads threads;
+    std::mt19937 rng(7);
+    my_vector<Keyed> records;
+    for (int i = 0; i < 40'000; ++i) {
+        records.push_back({static_cast<int>(rng() % 100), i});
+    }
+    auto by_key = [](const Keyed& a, const Keyed& b) { return a.key < b.key; };
+    my_vector<Keyed> expected = records;
+    std::stable_sort(expected.begin(), expected.end(), by_key);
+    myVector::parallel_stable_sort(records, by_key);
+    EXPECT_EQ(records, expected);
+
+    // -0.0 and 0.0 are equivalent, the radix path must not put all the negative zeros first
+    my_vector<float> zeros;
+    for (int i = 0; i < 10'000; ++i) {
+        zeros.push_back(i % 3 == 0 ? -0.0f : i % 3 == 1 ? 0.0f : static_cast<float>(i % 11) - 5.0f);
+    }
+    my_vector<float> stable = zeros;
+    std::stable_sort(stable.begin(), stable.end());
+    myVector::parallel_stable_sort(zeros);
+    ASSERT_EQ(zeros, stable);
+    EXPECT_TRUE(std::equal(zeros.begin(), zeros.end(), stable.begin(), stable.end(),
+                           [](float a, float b) { return std::signbit(a) == std::signbit(b); }));
+}
+
+TEST(MyVectorSort, NonTrivialElementsAndThrowingComparison) {
+    SortThreads threads;
+    my_vector<std::string> words;
+    for (int i = 0; i < 30'000; ++i) {
+        words.push_back(std::to_string((i * 7919) % 30'011) + "-word");
+    }
+    my_vector<std::string> expected = words;
+    std::sort(expected.begin(), expected.end(), std::greater<>{});
+    myVector::parallel_sort(words, std::greater<>{});
+    EXPECT_EQ(words, expected);
+
+    my_vector<int> values(20'000);
+    std::iota(values.begin(), values.end(), 0);
+    std::reverse(values.begin(), values.end());
+    int calls = 0;
+    std::mutex m;
+    auto throwing = [&](int a, int b) {
+        std::lock_guard<std::mutex> lock(m);
+        if (++calls == 100'000) throw std::runtime_error("comparison");
+        return a < b;
+    };
+    EXPECT_THROW(myVector::parallel_sort(values, throwing), std::runtime_error);
+    EXPECT_EQ(values.size(), 20'000u);
+}
+
+// constant evaluation
+namespace {
+    // built and sorted by my_vector at compile time, only the my_array survives
+    consteval my_array<int, 8> sorted_table() {
+        my_vector<int> v;
+        for (int i = 0; i < 8; ++i) {
+            v.push_back((i * 5 + 3) % 8);
+        }
+        v.insert(v.cbegin() + 2, 100);
+        v.erase(v.cbegin() + 2);
+        std::sort(v.begin(), v.end());
+        my_array<int, 8> out{};
+        std::copy(v.begin(), v.end(), out.begin());
+        return out;
+    }
+
+    consteval bool strings_survive_growth() {
+        my_vector<std::string> v{"b", "a"};
+        for (int i = 0; i < 40; ++i) {
+            v.emplace_back(1, static_cast<char>('c' + i % 20));
+        }
+        v.insert(v.cbegin(), 3, "z");
+        v.resize(50);
+        my_vector<std::string> copy = v;
+        copy.shrink_to_fit();
+        return copy == v && v.size() == 50 && v[0] == "z" && v[3] == "b" && v.back().empty();
+    }
+
+    // trivially relocatable, so the runtime would memcpy/memmove these
+    consteval int sum_after_erase() {
+        my_vector<std::unique_ptr<int>> v;
+        for (int i = 1; i <= 20; ++i) {
+            v.push_back(std::make_unique<int>(i));
+        }
+        v.erase(v.cbegin(), v.cbegin() + 10);
+        v.insert(v.cbegin(), std::make_unique<int>(-5));
+        int sum = 0;
+        for (const auto& p : v) {
+            sum += *p;
+        }
+        return sum;
+    }
+
+    consteval bool default_init_and_compare() {
+        my_vector<int> a;
+        a.resize_default_init(5);
+        a.append_n(3, 7);
+        my_vector<int> b(a.begin(), a.end());
+        b[7] = 8;
+        return a.size() == 8 && a[4] == 0 && a < b && a != b;
+    }
+}
+
+TEST(MyVectorConstexpr, CompileTimeTables) {
+    static constexpr my_array<int, 8> table = sorted_table();
+    static_assert(table == my_array<int, 8>{0, 1, 2, 3, 4, 5, 6, 7});
+    static_assert(strings_survive_growth());
+    static_assert(sum_after_erase() == 150);
+    static_assert(default_init_and_compare());
+    EXPECT_TRUE(std::is_sorted(table.begin(), table.end()));
+}
+
+// explicitly vectorized algorithms
+namespace {
+    // runs the checks once per register width the CPU has
+    template <typename Check>
+    void for_each_width(Check check) {
+        const std::size_t saved = myVector::simd::max_register_bytes;
+        for (std::size_t bytes : {16, 32, 64}) {
+            myVector::simd::max_register_bytes = bytes;
+            check();
+        }
+        myVector::simd::max_register_bytes = saved;
+    }
+
+    template <typename T>
+    void check_against_std(std::size_t n) {
+        SCOPED_TRACE(n);
+        namespace simd = myVector::simd;
+        my_vector<T> v(n, T{});
+        for (std::size_t i = 0; i < n; ++i) {
+            v[i] = static_cast<T>((i * 7 + 3) % 11); // small values, so float sums are exact
+        }
+
+        EXPECT_EQ(simd::sum(v), std::accumulate(v.begin(), v.end(), T{}));
+        EXPECT_EQ(simd::dot(v, v), std::inner_product(v.begin(), v.end(), v.begin(), T{}));
+        EXPECT_EQ(simd::count(v, T{3}), static_cast<std::size_t>(std::count(v.begin(), v.end(), T{3})));
+        EXPECT_EQ(simd::find(v, T{10}), static_cast<std::size_t>(std::find(v.begin(), v.end(), T{10}) - v.begin()));
+        EXPECT_EQ(simd::find(v, T{42}), n);
+        if (n > 0) {
+            v[n - 1] = T{42};
+            EXPECT_EQ(simd::find(v, T{42}), n - 1);
+            v[n / 2] = T{0} - T{1};
+            auto [lo, hi] = std::minmax_element(v.begin(), v.end());
+            EXPECT_EQ(simd::minmax(v), std::make_pair(*lo, *hi));
+        }
+
+        my_vector<T> out(n, T{});
+        simd::transform(v, out, [](T x) { return static_cast<T>(x * 2 + 1); });
+        for (std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(out[i], static_cast<T>(v[i] * 2 + 1));
+        }
+        std::vector<T> expected(n);
+        std::inclusive_scan(v.begin(), v.end(), expected.begin());
+        simd::inclusive_scan(v, v); // in place
+        EXPECT_TRUE(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+    }
+}
+
+TEST(Simd, MatchesStandardAlgorithms) {
+    for_each_width([] {
+        for (std::size_t n : {0, 1, 7, 16, 63, 64, 65, 200, 1000, 4099}) {
+            check_against_std<int>(n);
+            check_against_std<float>(n);
+            check_against_std<double>(n);
+            check_against_std<std::int64_t>(n);
+            check_against_std<std::uint16_t>(n);
+        }
+    });
+}
+
+TEST(Simd, NarrowCountersAndContainers) {
+    for_each_width([] {
+        // more matches than an 8-bit lane counter can hold
+        std::vector<std::int8_t> bytes(100'000, 5);
+        bytes[77'777] = 6;
+        EXPECT_EQ(myVector::simd::count(bytes, std::int8_t{5}), 99'999u);
+        EXPECT_EQ(myVector::simd::find(bytes, std::int8_t{6}), 77'777u);
+
+        my_array<float, 37> a{};
+        a.fill(0.5f);
+        a[36] = -2.0f;
+        EXPECT_EQ(myVector::simd::sum(a), 16.0f);
+        EXPECT_EQ(myVector::simd::minmax(std::span<const float>(a.data(), a.size())), std::make_pair(-2.0f, 0.5f));
+    });
+    my_vector<double> empty;
+    EXPECT_THROW(myVector::simd::minmax(empty), std::length_error);
+    EXPECT_THROW(myVector::simd::dot(empty, my_vector<double>(1, 1.0)), std::length_error);
+}
+
+// concurrent appends
+static_assert(std::random_access_iterator<myVector::concurrent_vector<int>::iterator>);
+static_assert(std::random_access_iterator<myVector::concurrent_vector<int>::const_iterator>);
+
+TEST(ConcurrentVector, ParallelAppends) {
+    myVector::concurrent_vector<int> v;
+    constexpr int threads = 4, per_thread = 20'000;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; ++t)
+    {
+        producers.emplace_back([&v, t] {
+            for (int i = 0; i < per_thread; ++i)
+            {
+                auto it = v.push_back(t * per_thread + i);
+                ASSERT_EQ(*it, t * per_thread + i); // readable right away, by address and by index
+                ASSERT_EQ(&v[static_cast<std::size_t>(it - v.begin())], &*it);
+            }
+            auto block = v.grow_by(100, -1);
+            ASSERT_TRUE(std::all_of(block, block + 100, [](int x) { return x == -1; }));
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    ASSERT_EQ(v.size(), std::size_t{threads * (per_thread + 100)});
+    my_vector<int> flat = v.to_my_vector();
+    ASSERT_TRUE(std::equal(flat.begin(), flat.end(), v.begin(), v.end()));
+    std::sort(flat.begin(), flat.end());
+    EXPECT_EQ(std::count(flat.begin(), flat.end(), -1), threads * 100);
+    EXPECT_EQ(flat[threads * 100], 0);
+    EXPECT_EQ(flat.back(), threads * per_thread - 1);
+    EXPECT_TRUE(std::adjacent_find(flat.begin() + threads * 100, flat.end()) == flat.end());
+}
+
+TEST(ConcurrentVector, StableAddressesAndHoles) {
+    myVector::concurrent_vector<ChunkProbe> v;
+    const int before = ChunkProbe::alive;
+    const ChunkProbe* first = &*v.emplace_back(1);
+    EXPECT_THROW(v.push_back(ChunkProbe(-1)), std::runtime_error);
+    v.grow_by(1000, ChunkProbe(2));
+    EXPECT_EQ(first, &v[0]);
+    EXPECT_EQ(v.size(), 1002u);
+    EXPECT_GE(v.capacity(), v.size());
+
+    my_vector<ChunkProbe> flat = v.to_my_vector(); // skips the element that failed
+    ASSERT_EQ(flat.size(), 1001u);
+    EXPECT_EQ(flat[0].value, 1);
+    EXPECT_EQ(flat[1].value, 2);
+    v.clear();
+    EXPECT_TRUE(v.is_empty());
+    flat.clear();
+    EXPECT_EQ(ChunkProbe::alive, before);
+}
+
+// segmented storage
+using myVector::my_segmented_vector;
+
+TEST(MySegmentedVector, GrowthKeepsAddresses) {
+    my_segmented_vector<std::string> v;
+    v.push_back("first");
+    const std::string* first = &v.front();
+    std::vector<const std::string*> addresses;
+    for (int i = 0; i < 1000; ++i)
+    {
+        v.push_back(std::to_string(i));
+        addresses.push_back(&v.back());
+    }
+    EXPECT_EQ(first, &v[0]);
+    EXPECT_EQ(*first, "first");
+    for (std::size_t i = 0; i < addresses.size(); ++i)
+    {
+        ASSERT_EQ(addresses[i], &v[i + 1]);
+    }
+    EXPECT_EQ(v.size(), 1001u);
+    EXPECT_EQ(v.capacity(), 1008u); // 16 + 32 + ... + 512
+    EXPECT_EQ(v.at(1000), "999");
+    EXPECT_THROW(v.at(1001), std::out_of_range);
+
+    v.resize(20);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 48u);
+    EXPECT_EQ(first, &v[0]);
+}
+
+TEST(MySegmentedVector, WorksWithAlgorithms) {
+    my_segmented_vector<int> v;
+    for (int i = 0; i < 5000; ++i)
+    {
+        v.push_back((i * 7919) % 5000);
+    }
+    std::sort(v.begin(), v.end());
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+    EXPECT_EQ(std::lower_bound(v.begin(), v.end(), 4321) - v.begin(), 4321);
+    EXPECT_EQ(*(v.end() - 1), 4999);
+    EXPECT_EQ(v.end() - v.begin(), 5000);
+    EXPECT_TRUE(std::equal(v.rbegin(), v.rend(), v.to_my_vector().rbegin()));
+
+    my_vector<int> expected(5000);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(v.to_my_vector(), expected);
+
+    my_segmented_vector<int> copy(v);
+    EXPECT_EQ(copy, v);
+    copy[4000] = -1;
+    EXPECT_GT(v, copy);
+    copy.pop_back();
+    EXPECT_LT(copy, v);
+    EXPECT_LT(my_segmented_vector<int>(v.begin(), v.begin() + 100), v);
+    my_segmented_vector<int> moved(std::move(copy));
+    EXPECT_TRUE(copy.is_empty());
+    EXPECT_EQ(moved.size(), 4999u);
+}
+
+static_assert(std::random_access_iterator<my_segmented_vector<int>::iterator>);
+static_assert(std::random_access_iterator<my_segmented_vector<int>::const_iterator>);
+
+TEST(MySegmentedVector, OrdersLikeMyVector) {
+    const my_vector<my_vector<int>> cases{{}, {2}, {1, 1}, {1, 2}, {1, 1, 1}, {3, 0}};
+    for (const auto& a : cases) {
+        for (const auto& b : cases) {
+            my_segmented_vector<int> sa(a.begin(), a.end()), sb(b.begin(), b.end());
+            EXPECT_EQ(sa <=> sb, a <=> b);
+            EXPECT_EQ(sa == sb, a == b);
+        }
+    }
+    my_vector<int> long_run(40, 7), longer_run(41, 0);
+    EXPECT_EQ(my_segmented_vector<int>(long_run.begin(), long_run.end()) <=> my_segmented_vector<int>(longer_run.begin(), longer_run.end()),
+              long_run <=> longer_run);
+}
+
+TEST(MySegmentedVector, AssignmentRespectsAllocators) {
+    AllocStats left_stats, right_stats;
+    {
+        using Alloc = CountingAllocator<int>;
+        my_segmented_vector<int, Alloc> left({1, 2, 3}, Alloc(&left_stats));
+        my_segmented_vector<int, Alloc> right({4, 5, 6, 7}, Alloc(&right_stats));
+        left = std::move(right);
+        EXPECT_EQ(left.get_allocator().stats, &left_stats);
+        EXPECT_EQ(left.to_my_vector(), (my_vector<int, Alloc>({4, 5, 6, 7}, Alloc(&left_stats))));
+        right = left;
+        EXPECT_EQ(right.get_allocator().stats, &right_stats);
+        EXPECT_EQ(right.size(), 4u);
+    }
+    EXPECT_EQ(left_stats.deallocations, left_stats.allocations);
+    EXPECT_EQ(right_stats.deallocations, right_stats.allocations);
+
+    AllocStats a_stats, b_stats;
+    {
+        using Alloc = CountingAllocator<int, true>;
+        my_segmented_vector<int, Alloc> a({1, 2}, Alloc(&a_stats));
+        my_segmented_vector<int, Alloc> b({3}, Alloc(&b_stats));
+        a = std::move(b);
+        EXPECT_EQ(a.get_allocator().stats, &b_stats);
+        my_segmented_vector<int, Alloc> c({9}, Alloc(&a_stats));
+        c = a;
+        EXPECT_EQ(c.get_allocator().stats, &b_stats);
+        EXPECT_EQ(c[0], 3);
+    }
+    EXPECT_EQ(a_stats.deallocations, a_stats.allocations);
+    EXPECT_EQ(b_stats.deallocations, b_stats.allocations);
+}
+
+// structure of arrays
+using myVector::soa_vector;
+
+TEST(SoaVector, ColumnsShareOneBlock) {
+    soa_vector<int, std::string, double> v;
+    for (int i = 0; i < 100; ++i)
+    {
+        v.push_back({i, std::to_string(i), i * 0.5});
+    }
+    ASSERT_EQ(v.size(), 100u);
+    EXPECT_GE(v.capacity(), 100u);
+
+    std::span<int> ids = v.column<0>();
+    std::span<double> halves = v.column<2>();
+    EXPECT_EQ(ids.size(), 100u);
+    EXPECT_EQ(std::accumulate(ids.begin(), ids.end(), 0), 4950);
+    EXPECT_DOUBLE_EQ(halves[99], 49.5);
+    // one allocation: the columns follow each other inside the block
+    EXPECT_LT(static_cast<const void*>(ids.data()), static_cast<const void*>(v.column<1>().data()));
+    EXPECT_LT(static_cast<const void*>(v.column<1>().data()), static_cast<const void*>(halves.data()));
+
+    auto [id, name, half] = v[42];
+    EXPECT_EQ(id, 42);
+    EXPECT_EQ(name, "42");
+    name = "forty-two"; // writes through
+    EXPECT_EQ(v.column<1>()[42], "forty-two");
+    v[0] = std::tuple<int, std::string, double>(-1, "minus one", -0.5);
+    EXPECT_EQ(v.front(), (std::tuple<int, std::string, double>(-1, "minus one", -0.5)));
+    EXPECT_THROW(v.at(100), std::out_of_range);
+
+    soa_vector<int, std::string, double> copy(v);
+    EXPECT_EQ(copy, v);
+    copy.pop_back();
+    EXPECT_FALSE(copy == v);
+    copy.shrink_to_fit();
+    EXPECT_EQ(copy.capacity(), 99u);
+    EXPECT_EQ(copy.column<1>()[98], "98");
+}
+
+TEST(SoaVector, RangesSortMovesWholeRows) {
+    soa_vector<int, std::string> v;
+    for (int i = 0; i < 1000; ++i)
+    {
+        v.emplace_back((i * 7919) % 1000, "row " + std::to_string((i * 7919) % 1000));
+    }
+    std::ranges::sort(v);
+    EXPECT_TRUE(std::ranges::is_sorted(v.column<0>()));
+    for (std::size_t i = 0; i < v.size(); ++i)
+    {
+        ASSERT_EQ(v.column<1>()[i], "row " + std::to_string(v.column<0>()[i]));
+    }
+
+    std::ranges::sort(v, std::ranges::greater{}, [](const auto& row) { return get<0>(row); });
+    EXPECT_EQ(v.column<0>().front(), 999);
+    EXPECT_EQ(v.column<1>().front(), "row 999");
+
+    v.resize(3);
+    EXPECT_EQ(v.back(), (std::tuple<int, std::string>(997, "row 997")));
+    v.resize(5);
+    EXPECT_EQ(v.back(), (std::tuple<int, std::string>(0, "")));
+    v.clear();
+    EXPECT_TRUE(v.is_empty());
+}
+
+// default-init resize
+TEST(MyVectorResize, DefaultInit) {
+    my_vector<int> v{1, 2};
+    v.resize_default_init(1000);
+    EXPECT_EQ(v.size(), 1000u);
+    EXPECT_EQ(v[1], 2);
+    std::iota(v.begin() + 2, v.end(), 3);
+    EXPECT_EQ(v.back(), 1000);
+    v.resize_default_init(3);
+    EXPECT_EQ(v.size(), 3u);
+
+    my_vector<std::string> s{"keep"};
+    s.resize_default_init(3);
+    EXPECT_EQ(s[0], "keep");
+    EXPECT_TRUE(s[2].empty());
+}
+
+TEST(MyVectorResize, ResizeAndOverwrite) {
+    const std::string payload = "hello, world";
+    my_vector<char> buffer{'>', ' '};
+    buffer.resize_and_overwrite(64, [&](char* data, size_t n) {
+        EXPECT_EQ(data[0], '>');
+        size_t written = std::min(n - 2, payload.size());
+        std::memcpy(data + 2, payload.data(), written);
+        return 2 + written;
+    });
+    EXPECT_EQ(std::string(buffer.begin(), buffer.end()), "> hello, world");
+    EXPECT_GE(buffer.capacity(), 64u);
+
+    buffer.resize_and_overwrite(1, [](char*, size_t n) { return n; });
+    EXPECT_EQ(buffer.size(), 1u);
+    EXPECT_THROW(buffer.resize_and_overwrite(4, [](char*, size_t n) { return n + 1; }), std::length_error);
+}
+
+// growth policies
+TEST(MyVectorGrowth, DefaultIsOneAndAHalf) {
+    my_vector<int> v;
+    std::vector<size_t> caps;
+    for (int i = 0; i < 20; ++i) {
+        v.push_back(i);
+        if (caps.empty() || caps.back() != v.capacity()) caps.push_back(v.capacity());
+    }
+    EXPECT_EQ(caps, (std::vector<size_t>{1, 2, 3, 4, 6, 9, 13, 19, 28}));
+}
+
+TEST(MyVectorGrowth, PoliciesShapeCapacity) {
+    my_vector<int, std::allocator<int>, myVector::double_growth> doubling;
+    my_vector<int, std::allocator<int>, myVector::chunk_growth<64>> chunked;
+    my_vector<int, std::allocator<int>, myVector::page_rounded_growth<>> paged;
+    for (int i = 0; i < 100; ++i) {
+        doubling.push_back(i);
+        chunked.push_back(i);
+        paged.push_back(i);
+    }
+    EXPECT_EQ(doubling.capacity(), 128u);
+    EXPECT_EQ(chunked.capacity() % 16, 0u);
+    EXPECT_EQ(paged.capacity(), 1024u);
+    EXPECT_EQ(doubling, (my_vector<int, std::allocator<int>, myVector::double_growth>(chunked.begin(), chunked.end())));
+}
+
+// sanitizers replace malloc, so only real glibc size classes are comparable
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+TEST(MyVectorGrowth, SizeClassMatchesMallocUsableSize) {
+    using policy = myVector::size_class_growth<myVector::growth_factor<5, 4>>;
+    for (size_t bytes : {1u, 8u, 24u, 25u, 100u, 1000u, 4000u}) {
+        void* p = std::malloc(bytes);
+        size_t usable = malloc_usable_size(p);
+        std::free(p);
+        EXPECT_EQ(policy::usable_size(bytes), usable) << bytes;
+    }
+    my_vector<char, std::allocator<char>, policy> v;
+    v.push_back('x');
+    EXPECT_EQ(v.capacity(), 24u);
+}
+#endif
+
+// small buffer optimization
+using myVector::my_small_vector;
+
+TEST(MySmallVector, StaysInlineUpToN) {
+    AllocStats stats;
+    my_small_vector<int, 8, CountingAllocator<int>> v{CountingAllocator<int>(&stats)};
+    for (int i = 0; i < 7; ++i) v.push_back(i);
+    v.insert(v.cbegin() + 2, 42);
+    v.erase(v.cbegin());
+    v.erase(v.cbegin() + 3, v.cend());
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(stats.allocations, 0);
+    EXPECT_EQ(v, (my_small_vector<int, 8, CountingAllocator<int>>({1, 42, 2}, CountingAllocator<int>(&stats))));
+}
+
+TEST(MySmallVector, SpillsOncePerGrowth) {
+    AllocStats stats;
+    {
+        my_small_vector<std::string, 4, CountingAllocator<std::string>> v{CountingAllocator<std::string>(&stats)};
+        int growths = 0;
+        for (int i = 0; i < 100; ++i) {
+            auto cap = v.capacity();
+            v.emplace_back(std::to_string(i));
+            if (v.capacity() != cap) ++growths;
+        }
+        EXPECT_FALSE(v.is_inline());
+        EXPECT_EQ(stats.allocations, growths);
+        v.erase(v.cbegin() + 3, v.cend());
+        v.shrink_to_fit();
+        EXPECT_TRUE(v.is_inline());
+        EXPECT_EQ(v[2], "2");
+        EXPECT_EQ(stats.deallocations, stats.allocations);
+    }
+    EXPECT_EQ(stats.deallocations, stats.allocations);
+}
+
+TEST(MySmallVector, MovesBetweenInlineAndHeap) {
+    AllocStats stats;
+    using Vec = my_small_vector<std::unique_ptr<int>, 2, CountingAllocator<std::unique_ptr<int>>>;
+    Vec small{CountingAllocator<std::unique_ptr<int>>(&stats)};
+    small.push_back(std::make_unique<int>(1));
+    Vec big{CountingAllocator<std::unique_ptr<int>>(&stats)};
+    for (int i = 0; i < 5; ++i) big.push_back(std::make_unique<int>(10 + i));
+    const int allocations = stats.allocations;
+
+    Vec moved_small(std::move(small));
+    Vec moved_big(std::move(big));
+    EXPECT_EQ(stats.allocations, allocations);   // heap buffer was stolen, inline one moved
+    EXPECT_TRUE(moved_small.is_inline());
+    EXPECT_EQ(*moved_small[0], 1);
+    EXPECT_EQ(*moved_big[4], 14);
+    EXPECT_TRUE(small.is_empty());
+    EXPECT_TRUE(big.is_empty());
+
+    moved_small.swap(moved_big);
+    EXPECT_EQ(moved_small.size(), 5u);
+    EXPECT_EQ(*moved_big[0], 1);
+    moved_small = std::move(moved_big);
+    EXPECT_TRUE(moved_small.is_inline());
+    EXPECT_EQ(*moved_small.front(), 1);
+}
+
+TEST(MySmallVector, SameInterfaceAsMyVector) {
+    my_small_vector<std::string, 3> v{"b", "d"};
+    v.insert(v.cbegin() + 1, "c");
+    v.insert(v.cbegin(), 2, "a");
+    std::istringstream words("x y");
+    v.insert(v.cend(), std::istream_iterator<std::string>(words), std::istream_iterator<std::string>());
+    EXPECT_EQ(v, (my_small_vector<std::string, 3>{"a", "a", "b", "c", "d", "x", "y"}));
+    std::vector<std::string> rev(v.rbegin(), v.rend());
+    EXPECT_EQ(rev.front(), "y");
+    EXPECT_TRUE((my_small_vector<int, 2>{1, 2} < my_small_vector<int, 2>{1, 3}));
+    EXPECT_TRUE((my_small_vector<double, 2>{1.0} < my_small_vector<double, 2>{1.0, 0.5}));
+    v.resize(1);
+    v.resize(3, "z");
+    EXPECT_EQ(v.back(), "z");
+    EXPECT_THROW(v.at(3), std::out_of_range);
+}
+
 // fundamental type tests
 TEST(MyArrayFundamental, DefaultCtorAndFill) {
     my_array<int, 3> a;
@@ -224,7 +1616,59 @@ TEST(MyArrayComparison, OperatorSpaceship) {
     EXPECT_TRUE(a == c);
 }
 
+// trivially copyable fast paths
+namespace {
+    constexpr my_array<int, 5> filled_then_swapped() {
+        my_array<int, 5> a{}, b{};
+        a.fill(3);
+        b.fill(-1);
+        a.swap(b);
+        my_array<int, 5> c(std::array<int, 5>{1, 2, 3, 4, 5});
+        a[4] = c[4];
+        return a;
+    }
+}
+
+TEST(MyArrayFastPaths, FillSwapConvert) {
+    static_assert(filled_then_swapped() == my_array<int, 5>{-1, -1, -1, -1, 5});
+
+    auto scratch = std::make_unique<my_array<float, 4096>>();
+    scratch->fill(0.0f);
+    EXPECT_TRUE(std::all_of(scratch->begin(), scratch->end(), [](float f) { return f == 0.0f && !std::signbit(f); }));
+    scratch->fill(-0.0f); // not one repeated byte
+    EXPECT_TRUE(std::all_of(scratch->begin(), scratch->end(), [](float f) { return std::signbit(f); }));
+    scratch->fill(1.5f);
+    EXPECT_TRUE(std::all_of(scratch->begin(), scratch->end(), [](float f) { return f == 1.5f; }));
+
+    // 300 * 3 bytes: whole 256-byte blocks plus a tail
+    struct rgb { unsigned char r, g, b; };
+    my_array<rgb, 300> x{}, y{};
+    x.fill({1, 2, 3});
+    y.fill({9, 9, 9});
+    x.swap(y);
+    EXPECT_EQ(x[299].r, 9);
+    EXPECT_EQ(y[0].g, 2);
+    EXPECT_EQ(y[299].b, 3);
+    x.swap(x);
+    EXPECT_EQ(x[150].g, 9);
+
+    my_array<std::string, 2> s1{"a", "b"}, s2{"c", "d"};
+    swap(s1, s2);
+    EXPECT_EQ(s1[1], "d");
+    EXPECT_EQ(s2[0], "a");
+
+    std::array<int, 4> source{1, -2, 3, -4};
+    my_array<int, 4> same(source);
+    my_array<long long, 4> widened(source);
+    EXPECT_EQ(same[3], -4);
+    EXPECT_EQ(widened[1], -2LL);
+    same = std::array<int, 4>{5, 6, 7, 8};
+    EXPECT_EQ(same, (my_array<int, 4>{5, 6, 7, 8}));
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
+    // the death tests fork a process that also has thread pool workers running
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
     return RUN_ALL_TESTS();
 }